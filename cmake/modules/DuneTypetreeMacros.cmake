@@ -0,0 +1,116 @@
+# SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+# SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+
+#[=======================================================================[.rst:
+DuneTypetreeMacros
+------------------
+
+Helpers for projects using dune-typetree. This file is included
+automatically by ``dune_project()`` of dune-typetree and of all modules
+depending on it.
+
+.. cmake:command:: dune_typetree_add_instantiations
+
+  Compile the tree traversals and transformations of a tree type once, in a
+  dedicated translation unit, instead of in every translation unit using them.
+
+  .. code-block:: cmake
+
+    dune_typetree_add_instantiations(<target>
+      NAME <name>
+      HEADER <header>
+      TREE <type>
+      [VISITORS <type>...]
+      [TRANSFORMATIONS <type>...]
+    )
+
+  ``NAME``
+    The base name of the generated files ``<name>.hh`` and ``<name>.cc`` in the
+    current binary directory. It must be unique within the directory.
+
+  ``HEADER``
+    The header declaring the tree, visitor and transformation types. Relative
+    paths are interpreted relative to the current source directory.
+
+  ``TREE``
+    The type of the tree.
+
+  ``VISITORS``
+    Visitor types to instantiate ``Dune::TypeTree::applyToTree(tree, visitor)`` for.
+    Both the tree and the visitor are passed as lvalues, the tree may be const.
+
+  ``TRANSFORMATIONS``
+    Transformation types to instantiate ``Dune::TypeTree::TransformTree::transform(tree, transformation)``
+    and ``Dune::TypeTree::TransformTree::transform_storage(treePointer, transformation)`` for.
+
+  The generated header ``<name>.hh`` includes ``<header>`` and declares the
+  instantiations ``extern``. Every translation unit of ``<target>`` that includes
+  it uses the instantiations compiled once in ``<name>.cc``, which is added to the
+  sources of ``<target>``. The current binary directory is added to the include
+  directories of ``<target>``.
+
+#]=======================================================================]
+include_guard(GLOBAL)
+
+function(dune_typetree_add_instantiations target)
+  cmake_parse_arguments(ARG "" "NAME;HEADER;TREE" "VISITORS;TRANSFORMATIONS" ${ARGN})
+  if(ARG_UNPARSED_ARGUMENTS)
+    message(FATAL_ERROR "dune_typetree_add_instantiations: unknown arguments ${ARG_UNPARSED_ARGUMENTS}")
+  endif()
+  foreach(arg NAME HEADER TREE)
+    if(NOT ARG_${arg})
+      message(FATAL_ERROR "dune_typetree_add_instantiations: ${arg} is required")
+    endif()
+  endforeach()
+
+  get_filename_component(header "${ARG_HEADER}" ABSOLUTE BASE_DIR "${CMAKE_CURRENT_SOURCE_DIR}")
+  string(MAKE_C_IDENTIFIER "${ARG_NAME}" guard)
+  string(TOUPPER "DUNE_TYPETREE_INSTANTIATIONS_${guard}_HH" guard)
+
+  set(instantiations "")
+  foreach(visitor IN LISTS ARG_VISITORS)
+    list(APPEND instantiations
+      "void Dune::TypeTree::applyToTree(${ARG_TREE}&, ${visitor}&)"
+      "void Dune::TypeTree::applyToTree(const ${ARG_TREE}&, ${visitor}&)")
+  endforeach()
+  foreach(transformation IN LISTS ARG_TRANSFORMATIONS)
+    set(transform "Dune::TypeTree::TransformTree<${ARG_TREE}, ${transformation}>")
+    set(storage "std::shared_ptr<const ${ARG_TREE}>")
+    list(APPEND instantiations
+      "${transform}::transformed_type ${transform}::transform(const ${ARG_TREE}&, const ${transformation}&)"
+      "${transform}::transformed_type ${transform}::transform(const ${ARG_TREE}&, ${transformation}&)"
+      "${transform}::transformed_storage_type ${transform}::transform_storage(${storage}, const ${transformation}&)"
+      "${transform}::transformed_storage_type ${transform}::transform_storage(${storage}, ${transformation}&)")
+  endforeach()
+
+  set(declarations "")
+  set(definitions "")
+  foreach(instantiation IN LISTS instantiations)
+    string(APPEND declarations "extern template ${instantiation};\n")
+    string(APPEND definitions "template ${instantiation};\n")
+  endforeach()
+
+  string(CONCAT header_content
+    "// generated by dune_typetree_add_instantiations(), do not edit\n"
+    "#ifndef ${guard}\n"
+    "#define ${guard}\n\n"
+    "#include <dune/typetree/transformation.hh>\n"
+    "#include <dune/typetree/traversal.hh>\n\n"
+    "#include \"${header}\"\n\n"
+    "${declarations}\n"
+    "#endif // ${guard}\n")
+  string(CONCAT source_content
+    "// generated by dune_typetree_add_instantiations(), do not edit\n"
+    "#include \"${ARG_NAME}.hh\"\n\n"
+    "${definitions}")
+
+  # only touch the generated files if their content changes, to avoid needless rebuilds
+  set(output "${CMAKE_CURRENT_BINARY_DIR}/${ARG_NAME}")
+  file(WRITE "${output}.hh.tmp" "${header_content}")
+  file(WRITE "${output}.cc.tmp" "${source_content}")
+  configure_file("${output}.hh.tmp" "${output}.hh" COPYONLY)
+  configure_file("${output}.cc.tmp" "${output}.cc" COPYONLY)
+
+  target_sources(${target} PRIVATE "${output}.cc")
+  target_include_directories(${target} PRIVATE "${CMAKE_CURRENT_BINARY_DIR}")
+endfunction()
@@ -9,6 +9,7 @@
 #include <dune/common/typetraits.hh>
 #include <dune/typetree/nodeinterface.hh>
 #include <dune/typetree/nodetags.hh>
+#include <dune/typetree/traversal.hh>
 #include <dune/typetree/treepath.hh>
 #include <dune/typetree/utility.hh>
 
@@ -593,11 +594,11 @@ namespace Dune {
           auto pre_val = visitor.pre(tree, treePath, std::forward<U>(current_val));
 
           // check which type of traversal is supported by the tree
-          using allowDynamicTraversal = Dune::Std::is_detected<Detail::DynamicTraversalConcept,Tree>;
-          using allowStaticTraversal = Dune::Std::is_detected<Detail::StaticTraversalConcept,Tree>;
+          constexpr bool allowDynamicTraversal = Detail::DynamicTraversable<Tree>;
+          constexpr bool allowStaticTraversal = Detail::StaticTraversable<Tree>;
 
           // the tree must support either dynamic or static traversal
-          static_assert(allowDynamicTraversal::value || allowStaticTraversal::value);
+          static_assert(allowDynamicTraversal || allowStaticTraversal);
 
           // the visitor may specify preferred dynamic traversal
           using preferDynamicTraversal = std::bool_constant<Visitor::treePathType == TreePathType::dynamic>;
@@ -631,7 +632,7 @@ namespace Dune {
 
           // apply visitor to children
           auto in_val = [&](){
-            if constexpr (allowStaticTraversal::value && not preferDynamicTraversal::value) {
+            if constexpr (allowStaticTraversal && not preferDynamicTraversal::value) {
               // get list of static indices
               auto indices = std::make_index_sequence<Tree::degree()>{};
 
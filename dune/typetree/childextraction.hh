@@ -53,12 +53,6 @@ namespace Dune {
         return std::forward<Node>(node);
       }
 
-      template<class NodePtr>
-      auto childStorageImpl (NodePtr&& nodePtr)
-      {
-        return std::forward<NodePtr>(nodePtr);
-      }
-
       // recursively call `node.child(...)` with the given indices
       template<class Node, class I0, class... I>
       decltype(auto) childImpl (Node&& node, I0 i0, [[maybe_unused]] I... i)
@@ -70,13 +64,25 @@ namespace Dune {
           return;
       }
 
-      // recursively call `node.childStorage(...)` with the given indices
-      template<class NodePtr, class I0, class... I>
-      decltype(auto) childStorageImpl (NodePtr&& nodePtr, I0 i0, [[maybe_unused]] I... i)
+      // call `node.childStorage(...)` on the parent of the requested child. The
+      // intermediate nodes are visited by reference, such that only the storage
+      // of the requested child is copied and no other reference count is touched.
+      template<class Node, class I0>
+      decltype(auto) childStorageImpl (Node&& node, I0 i0)
+      {
+        auto valid = checkChildIndex(node,i0);
+        if constexpr (valid)
+          return node.childStorage(i0);
+        else
+          return;
+      }
+
+      template<class Node, class I0, class I1, class... I>
+      decltype(auto) childStorageImpl (Node&& node, I0 i0, I1 i1, [[maybe_unused]] I... i)
       {
-        auto valid = checkChildIndex(*nodePtr,i0);
+        auto valid = checkChildIndex(node,i0);
         if constexpr (valid)
-          return childStorageImpl(nodePtr->childStorage(i0),i...);
+          return childStorageImpl(node.child(i0),i1,i...);
         else
           return;
       }
@@ -89,10 +95,10 @@ namespace Dune {
       }
 
       // forward to the impl methods by extracting the indices from the treepath
-      template<class NodePtr, class... Indices, std::size_t... i>
-      decltype(auto) childStorage (NodePtr&& nodePtr, [[maybe_unused]] HybridTreePath<Indices...> tp, std::index_sequence<i...>)
+      template<class Node, class... Indices, std::size_t... i>
+      decltype(auto) childStorage (Node&& node, [[maybe_unused]] HybridTreePath<Indices...> tp, std::index_sequence<i...>)
       {
-        return childStorageImpl(std::forward<NodePtr>(nodePtr),treePathEntry<i>(tp)...);
+        return childStorageImpl(std::forward<Node>(node),treePathEntry<i>(tp)...);
       }
 
     } // end namespace Impl
@@ -132,6 +138,15 @@ namespace Dune {
       return Impl::childImpl(std::forward<Node>(node),indices...);
     }
 
+    //! Extracts the storage of the child of a node given by a sequence of compile-time and run-time indices.
+    /**
+     * The nodes along the path are accessed by reference, only the storage object
+     * of the requested child is copied.
+     *
+     * \note Copying the storage of a child usually means copying a `shared_ptr`, i.e. modifying
+     *       an atomic reference count. In performance critical code, and in particular when several
+     *       threads access the same tree, prefer child(), which never touches a reference count.
+     */
     template<typename Node, typename... Indices>
 #ifdef DOXYGEN
     ImplementationDefined childStorage (Node&& node, Indices... indices)
@@ -140,7 +155,7 @@ namespace Dune {
 #endif
     {
       static_assert(sizeof...(Indices) > 0, "childStorage() cannot be called with an empty list of child indices");
-      return Impl::childStorageImpl(&node,indices...);
+      return Impl::childStorageImpl(node,indices...);
     }
 
     //! Extracts the child of a node given by a HybridTreePath object.
@@ -177,15 +192,19 @@ namespace Dune {
       return Impl::child(std::forward<Node>(node),tp,std::index_sequence_for<Indices...>{});
     }
 
+    //! Extracts the storage of the child of a node given by a HybridTreePath object.
+    /**
+     * \copydetails childStorage(Node&&,Indices...)
+     */
     template<typename Node, typename... Indices>
 #ifdef DOXYGEN
-    ImplementationDefined child (Node&& node, HybridTreePath<Indices...> treePath)
+    ImplementationDefined childStorage (Node&& node, HybridTreePath<Indices...> treePath)
 #else
     auto childStorage (Node&& node, HybridTreePath<Indices...> tp)
 #endif
     {
       static_assert(sizeof...(Indices) > 0, "childStorage() cannot be called with an empty TreePath");
-      return Impl::childStorage(&node,tp,std::index_sequence_for<Indices...>{});
+      return Impl::childStorage(node,tp,std::index_sequence_for<Indices...>{});
     }
 
 
@@ -0,0 +1,260 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+
+#ifndef DUNE_TYPETREE_DYNAMICFILTEREDNODE_HH
+#define DUNE_TYPETREE_DYNAMICFILTEREDNODE_HH
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/typetree/nodetags.hh>
+
+namespace Dune {
+  namespace TypeTree {
+
+    /** \addtogroup Nodes
+     *  \ingroup TypeTree
+     *  \{
+     */
+
+    //! Power node representing a filtered view on an underlying power node, with the filter chosen at run time.
+    /**
+     * In contrast to FilteredCompositeNode, the selection of children is not encoded
+     * in the type, but stored as a list of the original indices of the selected children.
+     * The filtered node behaves like a DynamicPowerNode with `degree()` equal to the
+     * number of selected children, and its `i`-th child is the `originalIndex(i)`-th
+     * child of the underlying node. Consequently, traversals of the filtered node only
+     * visit the selected children and never touch the excluded ones.
+     *
+     * The underlying node may be a PowerNode or a DynamicPowerNode. The selection can be
+     * changed at any time by means of setIndices() or filter(); this does not affect the
+     * underlying node.
+     *
+     * If constructed from a reference, the filtered node does not take ownership of the
+     * underlying node and accesses it without touching any reference count.
+     *
+     * \tparam Node The (possibly const) type of the underlying power node.
+     */
+    template<typename Node>
+    class DynamicFilteredNode
+    {
+
+      static_assert(Node::isPower, "DynamicFilteredNode requires a power node");
+
+      static const bool nodeIsConst = std::is_const<typename std::remove_reference<Node>::type>::value;
+
+      using UnfilteredChildType = typename std::remove_const_t<Node>::ChildType;
+
+    public:
+
+      //! Mark this class as non leaf in the \ref TypeTree.
+      static const bool isLeaf = false;
+
+      //! Mark this class as a power in the \ref TypeTree.
+      static const bool isPower = true;
+
+      //! Mark this class as a non composite in the \ref TypeTree.
+      static const bool isComposite = false;
+
+      //! The type tag that describes the node.
+      /**
+       * The number of selected children is only known at run time, so this node
+       * is a DynamicPowerNode regardless of the type of the underlying node.
+       */
+      typedef DynamicPowerNodeTag NodeTag;
+
+      //! The type of each child, const if the underlying node is const.
+      typedef std::conditional_t<nodeIsConst,const UnfilteredChildType,UnfilteredChildType> ChildType;
+
+      //! The storage type of each child.
+      typedef std::shared_ptr<ChildType> ChildStorageType;
+
+      //! The const version of the storage type of each child.
+      typedef std::shared_ptr<const UnfilteredChildType> ChildConstStorageType;
+
+      //! The number of selected children.
+      std::size_t degree () const
+      {
+        return _indices.size();
+      }
+
+      //! @name Child Access (Dynamic methods)
+      //! @{
+
+      //! Returns the i-th selected child.
+      /**
+       * \returns a reference to the originalIndex(i)-th child of the underlying node.
+       */
+      ChildType& child (std::size_t i)
+      {
+        return _node->child(originalIndex(i));
+      }
+
+      //! Returns the i-th selected child (const version).
+      /**
+       * \returns a const reference to the originalIndex(i)-th child of the underlying node.
+       */
+      const UnfilteredChildType& child (std::size_t i) const
+      {
+        return std::as_const(*_node).child(originalIndex(i));
+      }
+
+      //! Returns the storage of the i-th selected child.
+      /**
+       * \returns a copy of the object storing the i-th selected child.
+       */
+      ChildStorageType childStorage (std::size_t i)
+      {
+        return _node->childStorage(originalIndex(i));
+      }
+
+      //! Returns the storage of the i-th selected child (const version).
+      /**
+       * \returns a copy of the object storing the i-th selected child.
+       */
+      ChildConstStorageType childStorage (std::size_t i) const
+      {
+        return std::as_const(*_node).childStorage(originalIndex(i));
+      }
+
+      //! Sets the i-th selected child of the underlying node to the passed-in value.
+      template<typename C, bool enabled = !nodeIsConst,
+        std::enable_if_t<enabled, int> = 0>
+      void setChild (std::size_t i, C&& child)
+      {
+        _node->setChild(originalIndex(i), std::forward<C>(child));
+      }
+
+      //! @}
+
+      //! @name Selection of children
+      //! @{
+
+      //! Returns the index of the i-th selected child within the underlying node.
+      std::size_t originalIndex (std::size_t i) const
+      {
+        assert(i < degree() && "child index out of range");
+        return _indices[i];
+      }
+
+      //! Returns the original indices of all selected children.
+      const std::vector<std::size_t>& indices () const
+      {
+        return _indices;
+      }
+
+      //! Selects the children with the given original indices.
+      /**
+       * The children of the filtered node appear in the order of the passed indices.
+       * An original index may occur more than once.
+       */
+      void setIndices (std::vector<std::size_t> indices)
+      {
+        assert(checkIndices(indices) && "child index out of range");
+        _indices = std::move(indices);
+      }
+
+      //! Selects all children of the underlying node for which `predicate(child, originalIndex)` returns true.
+      template<typename Predicate>
+      void filter (Predicate&& predicate)
+      {
+        const Node& node = *_node;
+        _indices.clear();
+        for (std::size_t i = 0; i < std::size_t(node.degree()); ++i)
+          if (predicate(node.child(i), i))
+            _indices.push_back(i);
+      }
+
+      //! @}
+
+      //! @name Access to unfiltered node
+      //! @{
+
+    protected:
+
+      //! Returns the unfiltered node.
+      /**
+       * \returns A reference to the original, unfiltered node.
+       */
+      template<bool enabled = !nodeIsConst>
+      typename std::enable_if<enabled,Node&>::type
+      unfiltered ()
+      {
+        return *_node;
+      }
+
+      //! Returns the unfiltered node (const version).
+      /**
+       * \returns A const reference to the original, unfiltered node.
+       */
+      const Node& unfiltered () const
+      {
+        return *_node;
+      }
+
+      //! @}
+
+    public:
+
+      //! @name Constructors
+      //! @{
+
+      //! Initialize the filtered node with all children selected, without taking ownership of node.
+      DynamicFilteredNode (Node& node)
+        : _node(&node)
+        , _indices(std::size_t(node.degree()))
+      {
+        for (std::size_t i = 0; i < _indices.size(); ++i)
+          _indices[i] = i;
+      }
+
+      //! Initialize the filtered node with all children selected, sharing ownership of node.
+      DynamicFilteredNode (std::shared_ptr<Node> node)
+        : DynamicFilteredNode(*node)
+      {
+        _storage = std::move(node);
+      }
+
+      //! Initialize the filtered node with the children given by their original indices, without taking ownership of node.
+      DynamicFilteredNode (Node& node, std::vector<std::size_t> indices)
+        : _node(&node)
+      {
+        setIndices(std::move(indices));
+      }
+
+      //! Initialize the filtered node with the children given by their original indices, sharing ownership of node.
+      DynamicFilteredNode (std::shared_ptr<Node> node, std::vector<std::size_t> indices)
+        : DynamicFilteredNode(*node, std::move(indices))
+      {
+        _storage = std::move(node);
+      }
+
+      //! @}
+
+    private:
+
+      bool checkIndices (const std::vector<std::size_t>& indices) const
+      {
+        for (auto i : indices)
+          if (i >= std::size_t(_node->degree()))
+            return false;
+        return true;
+      }
+
+      Node* _node;
+      std::shared_ptr<Node> _storage;
+      std::vector<std::size_t> _indices;
+    };
+
+    //! \} group Nodes
+
+  } // namespace TypeTree
+} //namespace Dune
+
+#endif // DUNE_TYPETREE_DYNAMICFILTEREDNODE_HH
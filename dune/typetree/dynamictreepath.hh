@@ -0,0 +1,371 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+
+#ifndef DUNE_TYPETREE_DYNAMICTREEPATH_HH
+#define DUNE_TYPETREE_DYNAMICTREEPATH_HH
+
+#include <algorithm>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <utility>
+
+#include <dune/common/hybridutilities.hh>
+#include <dune/common/rangeutilities.hh>
+
+#include <dune/typetree/fixedcapacitystack.hh>
+#include <dune/typetree/treepath.hh>
+
+namespace Dune {
+  namespace TypeTree {
+
+    //! \addtogroup TreePath
+    //! \ingroup TypeTree
+    //! \{
+
+    //! A tree path whose length is only known at run time.
+    /**
+     * In contrast to `HybridTreePath`, the length of a `DynamicTreePath` is not
+     * encoded in its type, and all entries are stored as `std::size_t`. This allows
+     * to store paths to arbitrary nodes of a tree in a single homogeneous container,
+     * e.g. to collect the paths of all leaf nodes of a composite tree in a `std::vector`.
+     *
+     * Paths with at most `inlineCapacity` entries are stored inside the object itself;
+     * only longer paths allocate memory on the heap.
+     *
+     * Every `HybridTreePath` implicitly converts into a `DynamicTreePath` with the same
+     * entry values:
+     *
+     * \code{.cc}
+     * std::vector<DynamicTreePath> paths;
+     * forEachLeafNode(tree, [&](auto&& node, auto treePath) {
+     *   paths.push_back(treePath);
+     * });
+     * \endcode
+     */
+    class DynamicTreePath
+    {
+
+    public:
+
+      //! The type of the entries of this path.
+      using value_type = std::size_t;
+
+      using size_type = std::size_t;
+      using reference = std::size_t&;
+      using const_reference = const std::size_t&;
+      using iterator = std::size_t*;
+      using const_iterator = const std::size_t*;
+
+      //! Number of entries that can be stored without allocating heap memory.
+      static constexpr std::size_t inlineCapacity = 8;
+
+      //! Constructs an empty path referring to the root of a tree.
+      DynamicTreePath () noexcept
+        : _data(_inline)
+      {}
+
+      //! Constructs a path from a list of indices.
+      DynamicTreePath (std::initializer_list<std::size_t> indices)
+        : DynamicTreePath()
+      {
+        assign(indices.begin(),indices.end());
+      }
+
+      //! Converts a `HybridTreePath` into a `DynamicTreePath` with the same entry values.
+      template<typename... T>
+      DynamicTreePath (const HybridTreePath<T...>& tp)
+        : DynamicTreePath()
+      {
+        reserve(sizeof...(T));
+        Dune::Hybrid::forEach(tp, [&](auto i) {
+          _data[_size++] = i;
+        });
+      }
+
+      //! Takes a snapshot of the tree path passed to visitors during in-place traversal.
+      DynamicTreePath (const FixedCapacityStackView<std::size_t>& tp)
+        : DynamicTreePath()
+      {
+        assign(tp.begin(),tp.end());
+      }
+
+      DynamicTreePath (const DynamicTreePath& other)
+        : DynamicTreePath()
+      {
+        assign(other.begin(),other.end());
+      }
+
+      DynamicTreePath (DynamicTreePath&& other) noexcept
+        : DynamicTreePath()
+      {
+        moveFrom(other);
+      }
+
+      DynamicTreePath& operator= (const DynamicTreePath& other)
+      {
+        if (this != &other)
+          assign(other.begin(),other.end());
+        return *this;
+      }
+
+      DynamicTreePath& operator= (DynamicTreePath&& other) noexcept
+      {
+        if (this != &other)
+        {
+          _heap.reset();
+          _data = _inline;
+          _capacity = inlineCapacity;
+          moveFrom(other);
+        }
+        return *this;
+      }
+
+      //! @name Size and capacity
+      //! @{
+
+      //! Get the size (length) of this path.
+      [[nodiscard]] std::size_t size () const noexcept
+      {
+        return _size;
+      }
+
+      //! Returns true if this path refers to the root node.
+      [[nodiscard]] bool empty () const noexcept
+      {
+        return _size == 0;
+      }
+
+      //! The number of entries that can be stored without reallocation.
+      [[nodiscard]] std::size_t capacity () const noexcept
+      {
+        return _capacity;
+      }
+
+      //! Make sure that at least n entries can be stored without reallocation.
+      void reserve (std::size_t n)
+      {
+        if (n <= _capacity)
+          return;
+        std::size_t newCapacity = std::max(n, 2*_capacity);
+        auto newHeap = std::make_unique<std::size_t[]>(newCapacity);
+        std::copy(begin(),end(),newHeap.get());
+        _heap = std::move(newHeap);
+        _data = _heap.get();
+        _capacity = newCapacity;
+      }
+
+      //! @}
+
+      //! @name Element access
+      //! @{
+
+      //! Get the index value at position pos.
+      [[nodiscard]] std::size_t operator[] (std::size_t pos) const
+      {
+        assert(pos < _size);
+        return _data[pos];
+      }
+
+      //! Get a mutable reference to the index value at position pos.
+      [[nodiscard]] std::size_t& operator[] (std::size_t pos)
+      {
+        assert(pos < _size);
+        return _data[pos];
+      }
+
+      //! Get the first index value. Only available in non-empty paths.
+      [[nodiscard]] std::size_t front () const
+      {
+        assert(!empty());
+        return _data[0];
+      }
+
+      //! Get the last index value. Only available in non-empty paths.
+      [[nodiscard]] std::size_t back () const
+      {
+        assert(!empty());
+        return _data[_size-1];
+      }
+
+      const_iterator begin () const noexcept { return _data; }
+      const_iterator end () const noexcept { return _data + _size; }
+      iterator begin () noexcept { return _data; }
+      iterator end () noexcept { return _data + _size; }
+
+      //! @}
+
+      //! @name Modifiers
+      //! @{
+
+      //! Append the index i to this path.
+      void push_back (std::size_t i)
+      {
+        if (_size == _capacity)
+          reserve(_size+1);
+        _data[_size++] = i;
+      }
+
+      //! Remove the last index from this path.
+      void pop_back ()
+      {
+        assert(!empty());
+        --_size;
+      }
+
+      //! Remove all entries, turning this path into a path to the root node.
+      void clear () noexcept
+      {
+        _size = 0;
+      }
+
+      //! @}
+
+      //! Compare two `DynamicTreePath`s for value equality.
+      friend bool operator== (const DynamicTreePath& lhs, const DynamicTreePath& rhs)
+      {
+        return std::equal(lhs.begin(),lhs.end(),rhs.begin(),rhs.end());
+      }
+
+      //! Lexicographic three-way comparison, consistent with the one of `HybridTreePath`.
+      friend std::strong_ordering operator<=> (const DynamicTreePath& lhs, const DynamicTreePath& rhs)
+      {
+        return std::lexicographical_compare_three_way(lhs.begin(),lhs.end(),rhs.begin(),rhs.end());
+      }
+
+      //! Dumps a `DynamicTreePath` to a stream.
+      friend std::ostream& operator<< (std::ostream& os, const DynamicTreePath& tp)
+      {
+        os << "DynamicTreePath< ";
+        for (auto i : tp)
+          os << i << " ";
+        os << ">";
+        return os;
+      }
+
+    private:
+
+      template<typename It>
+      void assign (It first, It last)
+      {
+        _size = 0;
+        reserve(std::distance(first,last));
+        _size = std::copy(first,last,_data) - _data;
+      }
+
+      // take over the heap storage of other or copy its inline entries
+      void moveFrom (DynamicTreePath& other) noexcept
+      {
+        if (other._heap)
+        {
+          _heap = std::move(other._heap);
+          _data = _heap.get();
+          _capacity = other._capacity;
+          other._data = other._inline;
+          other._capacity = inlineCapacity;
+        }
+        else
+          std::copy(other.begin(),other.end(),_data);
+        _size = other._size;
+        other._size = 0;
+      }
+
+      std::size_t _inline[inlineCapacity];
+      std::unique_ptr<std::size_t[]> _heap;
+      std::size_t* _data;
+      std::size_t _size = 0;
+      std::size_t _capacity = inlineCapacity;
+
+    };
+
+    //! Compute a hash value for a `DynamicTreePath`.
+    /**
+     * The hash is compatible with the one of `HybridTreePath`, i.e. a `HybridTreePath`
+     * and its conversion to a `DynamicTreePath` have the same hash value.
+     */
+    [[nodiscard]] inline std::size_t hash_value (const DynamicTreePath& tp)
+    {
+      std::size_t seed = tp.size();
+      for (auto i : tp)
+        seed = Dune::Impl::hashCombine(seed, i);
+      return seed;
+    }
+
+#ifndef DOXYGEN
+
+    namespace Impl {
+
+      template<class Node, class F>
+      void applyToChild (Node&& node, const DynamicTreePath& tp, std::size_t pos, F& f)
+      {
+        using N = std::decay_t<Node>;
+        if (pos == tp.size())
+          f(node);
+        else if constexpr (not N::isLeaf)
+        {
+          std::size_t i = tp[pos];
+          assert(i < std::size_t(node.degree()) && "Child index out of range");
+          if constexpr (requires { node.child(i); })
+            applyToChild(node.child(i), tp, pos+1, f);
+          else
+            // translate the run time index into a compile time index
+            Dune::Hybrid::forEach(Dune::range(node.degree()), [&](auto k) {
+              if (k == i)
+                applyToChild(node.child(k), tp, pos+1, f);
+            });
+        }
+        else
+          assert(false && "DynamicTreePath is too long for this tree");
+      }
+
+    } // end namespace Impl
+
+#endif // DOXYGEN
+
+    //! Apply a callback to the child of a node given by a `DynamicTreePath`.
+    /**
+     * As the length of a `DynamicTreePath` is only known at run time, the type of
+     * the addressed child cannot be determined at compile time in general. Hence,
+     * unlike `child()`, this function does not return the child but passes it
+     * to the given callback, which must accept every node type reachable from node.
+     *
+     * Children of nodes supporting dynamic child access (like `PowerNode` and
+     * `DynamicPowerNode`) are looked up directly, for all other nodes the run time
+     * index is dispatched to the matching compile time index.
+     *
+     * \param node The node from which to extract the child.
+     * \param tp   The path of the wanted child relative to node.
+     * \param f    Callback that is invoked with the child.
+     */
+    template<class Node, class F>
+    void applyToChild (Node&& node, const DynamicTreePath& tp, F&& f)
+    {
+      Impl::applyToChild(node, tp, 0, f);
+    }
+
+    //! \} group TreePath
+
+  } // namespace TypeTree
+} //namespace Dune
+
+// Implement std::hash for DynamicTreePath
+namespace std {
+
+  template<>
+  struct hash<Dune::TypeTree::DynamicTreePath>
+  {
+    std::size_t operator()(const Dune::TypeTree::DynamicTreePath& tp) const noexcept
+    {
+      return Dune::TypeTree::hash_value(tp);
+    }
+  };
+
+}
+
+#endif // DUNE_TYPETREE_DYNAMICTREEPATH_HH
@@ -9,6 +9,7 @@
 #include <memory>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 #include <dune/typetree/nodetags.hh>
 #include <dune/typetree/filters.hh>
@@ -78,6 +79,10 @@ namespace Dune {
 
 
     //! Base class for composite nodes representing a filtered view on an underlying composite node.
+    /**
+     * If constructed from a reference, the filtered node does not take ownership of the
+     * underlying node and accesses it without touching any reference count.
+     */
     template<typename Node, typename Filter>
     class FilteredCompositeNode
     {
@@ -225,7 +230,7 @@ namespace Dune {
       typename std::enable_if<enabled,std::shared_ptr<Node> >::type
       unfilteredStorage ()
       {
-        return _node;
+        return _storage ? _storage : stackobject_to_shared_ptr(*_node);
       }
 
       //! Returns the storage object of the unfiltered node (const version).
@@ -234,7 +239,9 @@ namespace Dune {
        */
       std::shared_ptr<const Node> unfilteredStorage () const
       {
-        return _node;
+        if (_storage)
+          return _storage;
+        return stackobject_to_shared_ptr(std::as_const(*_node));
       }
 
       //! @}
@@ -244,20 +251,22 @@ namespace Dune {
       //! @name Constructors
       //! @{
 
-      //! Initialize the CompositeNode with copies of the passed in Storage objects.
+      //! Initialize the CompositeNode, sharing ownership of the unfiltered node.
       FilteredCompositeNode (std::shared_ptr<Node> node)
-        : _node(std::move(node))
+        : _node(node.get())
+        , _storage(std::move(node))
       {}
 
-      //! Initialize the CompositeNode with a copy of the passed-in storage type.
+      //! Initialize the CompositeNode with a reference to the unfiltered node, without taking ownership.
       FilteredCompositeNode (Node& node)
-        : _node(stackobject_to_shared_ptr(node))
+        : _node(&node)
       {}
 
       //! @}
 
     private:
-      std::shared_ptr<Node> _node;
+      Node* _node;
+      std::shared_ptr<Node> _storage;
     };
 
     //! \} group Nodes
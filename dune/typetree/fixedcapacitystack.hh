@@ -111,6 +111,16 @@ namespace Dune {
         return _impl._data[k];
       }
 
+      const T* begin() const
+      {
+        return _impl._data;
+      }
+
+      const T* end() const
+      {
+        return _impl._data + _impl._size;
+      }
+
     private:
       Impl& _impl;
 
@@ -131,6 +141,9 @@ namespace Dune {
       using view_base::back;
       using view_base::front;
       using view_base::size;
+      using view_base::empty;
+      using view_base::begin;
+      using view_base::end;
       using view_base::operator[];
 
       FixedCapacityStack()
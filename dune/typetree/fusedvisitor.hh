@@ -0,0 +1,206 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+
+#ifndef DUNE_TYPETREE_FUSEDVISITOR_HH
+#define DUNE_TYPETREE_FUSEDVISITOR_HH
+
+#include <bitset>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/indices.hh>
+
+#include <dune/typetree/traversal.hh>
+#include <dune/typetree/treepath.hh>
+#include <dune/typetree/visitor.hh>
+
+namespace Dune {
+  namespace TypeTree {
+
+    /** \addtogroup Tree Traversal
+     *  \ingroup TypeTree
+     *  \{
+     */
+
+    //! A visitor applying several visitors in a single traversal, see fuseVisitors().
+    /**
+     * \tparam Visitors The types of the fused visitors. Reference types are stored as
+     *                  references, all other types by value.
+     */
+    template<class... Visitors>
+    class FusedVisitor
+    {
+      static_assert(sizeof...(Visitors) > 0, "At least one visitor has to be fused");
+
+      static constexpr bool allInPlace = ((std::decay_t<Visitors>::treePathType == TreePathType::inPlace) && ...);
+      static constexpr bool noneInPlace = ((std::decay_t<Visitors>::treePathType != TreePathType::inPlace) && ...);
+      static constexpr bool allDynamic = ((std::decay_t<Visitors>::treePathType == TreePathType::dynamic) && ...);
+
+      static_assert(allInPlace or noneInPlace,
+        "Visitors with in-place tree paths can only be fused with each other");
+
+      // Bit j is set if the j-th visitor visits the current node
+      using Mask = std::bitset<sizeof...(Visitors)>;
+
+    public:
+
+      //! The fused visitors use dynamic tree paths only if all of them do.
+      static constexpr TreePathType::Type treePathType
+        = allInPlace ? TreePathType::inPlace : allDynamic ? TreePathType::dynamic : TreePathType::fullyStatic;
+
+      //! Visit a child if any of the fused visitors visits it.
+      template<class Node, class Child, class TreePath>
+      struct VisitChild
+      {
+        static const bool value = (std::decay_t<Visitors>::template VisitChild<Node,Child,TreePath>::value || ...);
+      };
+
+      //! Store the visitors, references are stored as references.
+      template<class... V>
+      explicit FusedVisitor (V&&... visitors)
+        : _visitors(std::forward<V>(visitors)...)
+      {}
+
+      template<class T, class TreePath>
+      auto pre (T&& t, TreePath treePath)
+      {
+        return forEachVisitor(active(treePath), [&](auto& visitor) { return visitor.pre(t, treePath); });
+      }
+
+      template<class T, class TreePath>
+      auto in (T&& t, TreePath treePath)
+      {
+        return forEachVisitor(active(treePath), [&](auto& visitor) { return visitor.in(t, treePath); });
+      }
+
+      template<class T, class TreePath>
+      auto post (T&& t, TreePath treePath)
+      {
+        return forEachVisitor(active(treePath), [&](auto& visitor) { return visitor.post(t, treePath); });
+      }
+
+      template<class T, class TreePath>
+      auto leaf (T&& t, TreePath treePath)
+      {
+        return forEachVisitor(active(treePath), [&](auto& visitor) { return visitor.leaf(t, treePath); });
+      }
+
+      template<class T, class Child, class TreePath, class ChildIndex>
+      auto beforeChild (T&& t, Child&& child, TreePath treePath, ChildIndex i)
+      {
+        const Mask mask = active(treePath);
+
+        // the child is visited by those visitors that visit the node and accept the child
+        using Node = std::remove_reference_t<T>;
+        Mask accepted;
+        unpackIntegerSequence([&](auto... j) {
+          ((accepted[j] = std::decay_t<Visitors>::template VisitChild<Node,std::decay_t<Child>,TreePath>::value), ...);
+        }, std::index_sequence_for<Visitors...>{});
+        std::size_t depth = treePath.size();
+        if (_active.size() < depth + 2)
+          _active.resize(depth + 2);
+        _active[depth + 1] = mask & accepted;
+
+        return forEachVisitor(mask, [&](auto& visitor) { return visitor.beforeChild(t, child, treePath, i); });
+      }
+
+      template<class T, class Child, class TreePath, class ChildIndex>
+      auto afterChild (T&& t, Child&& child, TreePath treePath, ChildIndex i)
+      {
+        return forEachVisitor(active(treePath), [&](auto& visitor) { return visitor.afterChild(t, child, treePath, i); });
+      }
+
+      //! The j-th fused visitor.
+      template<std::size_t j>
+      decltype(auto) visitor (index_constant<j> = {})
+      {
+        return std::get<j>(_visitors);
+      }
+
+    private:
+
+      // the visitors visiting the node at treePath, which was set up by beforeChild()
+      template<class TreePath>
+      Mask active (const TreePath& treePath)
+      {
+        std::size_t depth = treePath.size();
+        if (depth == 0)
+          return Mask().set();
+        return _active[depth];
+      }
+
+      /* Call f for all visitors in mask, in order. If any of the visitors
+       * can stop the traversal, a TraversalStatus is returned, which stops
+       * the traversal if any of the visitors called has requested it.
+       */
+      template<class F>
+      auto forEachVisitor (const Mask& mask, F&& f)
+      {
+        return unpackIntegerSequence([&](auto... j) {
+          constexpr bool canStop = (std::is_same_v<std::decay_t<decltype(f(std::get<decltype(j)::value>(_visitors)))>, TraversalStatus> || ...);
+          if constexpr (canStop) {
+            bool proceed = true;
+            ((mask[j] and not Detail::invokeCallback([&]{ return f(std::get<decltype(j)::value>(_visitors)); }) ? proceed = false : true), ...);
+            return proceed ? TraversalStatus::proceed : TraversalStatus::stop;
+          }
+          else
+            ((mask[j] ? (void)f(std::get<decltype(j)::value>(_visitors)) : void()), ...);
+        }, std::index_sequence_for<Visitors...>{});
+      }
+
+      std::tuple<Visitors...> _visitors;
+      std::vector<Mask> _active;
+    };
+
+    //! Fuse several visitors into a single one, such that they are applied in a single traversal.
+    /**
+     * \code
+     #include <dune/typetree/fusedvisitor.hh>
+     * \endcode
+     * Applying the returned visitor by applyToTree() has the same effect as applying all
+     * visitors one after another, but the tree is only traversed once, provided that no
+     * visitor depends on results another one only completes at the end of its traversal:
+     *
+     * \code{.cc}
+     * applyToTree(tree, fuseVisitors(bindVisitor, sizeVisitor, offsetVisitor));
+     * \endcode
+     *
+     * Every method of the fused visitor calls the respective method of the given visitors,
+     * in the order in which they were passed. A child is visited if any of the visitors visits
+     * it, i.e. the `VisitChild` decisions are combined by logical or. Nevertheless, every visitor
+     * is only called for the nodes it would see in a separate traversal: a visitor that rejects a
+     * child is not called for any node in the subtree of that child. As this is decided at run
+     * time, the methods of all visitors have to be callable for all visited nodes, which is the
+     * case for visitors derived from DefaultVisitor.
+     *
+     * The tree paths are dynamic if all visitors use DynamicTraversal, and static otherwise.
+     * Visitors using InPlaceTraversal can only be fused with each other.
+     *
+     * If any of the visitors returns TraversalStatus::stop, the remaining visitors are still
+     * called for the current node, and the traversal ends afterwards for all of them.
+     *
+     * \note The fused visitor keeps track of the visitors visiting the current node, so it can
+     *       be used for one traversal at a time only. In particular, it must not be used with the
+     *       parallel applyToTree().
+     *
+     * \param visitors The visitors to fuse. Visitors passed as lvalues are stored by reference,
+     *                 such that their state can be inspected after the traversal, all others
+     *                 are moved into the fused visitor.
+     */
+    template<class... Visitors>
+    FusedVisitor<Visitors...> fuseVisitors (Visitors&&... visitors)
+    {
+      return FusedVisitor<Visitors...>(std::forward<Visitors>(visitors)...);
+    }
+
+    //! \} group Tree Traversal
+
+  } // namespace TypeTree
+} //namespace Dune
+
+#endif // DUNE_TYPETREE_FUSEDVISITOR_HH
@@ -6,8 +6,11 @@
 #ifndef DUNE_TYPETREE_HYBRIDMULTIINDEX_HH
 #define DUNE_TYPETREE_HYBRIDMULTIINDEX_HH
 
+#include <algorithm>
 #include <cstddef>
 #include <cassert>
+#include <compare>
+#include <functional>
 #include <iostream>
 #include <type_traits>
 
@@ -63,6 +66,14 @@ namespace Dune {
       }
     }
 
+    // Mix the value v into the hash seed. This is the combination step known from
+    // boost::hash_combine, but without going through std::hash such that it can be
+    // evaluated in constant expressions.
+    constexpr std::size_t hashCombine(std::size_t seed, std::size_t v)
+    {
+      return seed ^ (v + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    }
+
   }
 
   /**
@@ -457,6 +468,48 @@ namespace Dune {
     return std::bool_constant<result>{};
   }
 
+  //! Lexicographic three-way comparison of two `HybridMultiIndex`s
+  /**
+   * The entries are compared by value, irrespective of whether they are
+   * stored as compile time or run time indices. If one multi-index is a
+   * prefix of the other, the shorter one is ordered first.
+   *
+   * This induces a strict weak ordering compatible with `operator==`, such
+   * that `HybridMultiIndex` can be used as key in ordered containers.
+   **/
+  template <class... S, class... T>
+  [[nodiscard]] constexpr std::strong_ordering operator<=>(
+    const HybridMultiIndex<S...>& lhs,
+    const HybridMultiIndex<T...>& rhs)
+  {
+    constexpr std::size_t n = std::min(sizeof...(S), sizeof...(T));
+    std::strong_ordering result = std::strong_ordering::equal;
+    unpackIntegerSequence([&](auto... i){
+      ((result = (result == 0) ? (std::size_t(lhs[i]) <=> std::size_t(rhs[i])) : result), ...);
+    }, std::make_index_sequence<n>{});
+    if (result != 0)
+      return result;
+    return sizeof...(S) <=> sizeof...(T);
+  }
+
+  //! Compute a hash value for a `HybridMultiIndex`
+  /**
+   * The hash only depends on the values of the entries, such that multi-indices
+   * comparing equal by `operator==` have the same hash value, independent of
+   * whether their entries are stored as compile time or run time indices.
+   * Compile time entries are folded into constants by the compiler. For a
+   * purely static multi-index, the hash can be evaluated at compile time.
+   **/
+  template<typename... T>
+  [[nodiscard]] constexpr std::size_t hash_value(const HybridMultiIndex<T...>& tp)
+  {
+    return unpackIntegerSequence([&](auto... i){
+      std::size_t seed = sizeof...(T);
+      ((seed = Impl::hashCombine(seed, std::size_t(tp[i]))), ...);
+      return seed;
+    }, tp.enumerate());
+  }
+
   //! Dumps a `HybridMultiIndex` to a stream.
   template<typename... T>
   std::ostream& operator<<(std::ostream& os, const HybridMultiIndex<T...>& tp)
@@ -473,7 +526,7 @@ namespace Dune {
 
 
 
-// Implement the tuple-protocol for HybridMultiIndex
+// Implement the tuple-protocol and std::hash for HybridMultiIndex
 namespace std {
 
   template<typename... T>
@@ -485,6 +538,16 @@ namespace std {
     using type = std::tuple_element_t<i, std::tuple<T...> >;
   };
 
+  //! Hash specialization allowing to use `HybridMultiIndex` as key in unordered containers.
+  template<typename... T>
+  struct hash<Dune::HybridMultiIndex<T...>>
+  {
+    constexpr std::size_t operator()(const Dune::HybridMultiIndex<T...>& tp) const noexcept
+    {
+      return Dune::hash_value(tp);
+    }
+  };
+
 }
 
 
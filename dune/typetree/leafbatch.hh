@@ -0,0 +1,349 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+
+#ifndef DUNE_TYPETREE_LEAFBATCH_HH
+#define DUNE_TYPETREE_LEAFBATCH_HH
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/indices.hh>
+
+#include <dune/typetree/nodeinterface.hh>
+#include <dune/typetree/traversal.hh>
+#include <dune/typetree/treepath.hh>
+
+namespace Dune {
+  namespace TypeTree {
+
+    /** \addtogroup Tree Traversal
+     *  \ingroup TypeTree
+     *  \{
+     */
+
+    //! Check whether Node is a power node whose children are leaf nodes.
+    template<class Node>
+    constexpr bool isLeafPowerNode()
+    {
+      using N = std::decay_t<Node>;
+      if constexpr (N::isPower && requires { typename N::ChildType; })
+        return N::ChildType::isLeaf;
+      else
+        return false;
+    }
+
+    //! A batch of the leaf children of a power node.
+    /**
+     * A LeafBatch wraps a power node whose children are all leaf nodes of type
+     * `PowerNode::ChildType` and presents them as a sequence of lanes, where lane
+     * `l` is the `l`-th child of the power node. This allows to process all components
+     * of e.g. a vector-valued function space basis at once.
+     *
+     * The number of lanes is available as `std::integral_constant` if the power node
+     * has a static degree (see StaticDegree), and as `std::size_t` otherwise. It is
+     * also returned by the free function `lanes()`, while `lane()` returns a single leaf.
+     *
+     * \note The names of `lanes()` and `lane()` are borrowed from `Dune::Simd`, but
+     *       LeafBatch is not a SIMD type: `Dune::Simd::lanes()` and `Dune::Simd::lane()`
+     *       cannot be called on it, as they require a compile-time lane count.
+     *
+     * \note The batch does not copy or own the leaves, it only refers to the power node.
+     *
+     * \tparam PowerNode The (possibly const) type of the wrapped power node.
+     */
+    template<class PowerNode>
+    class LeafBatch
+    {
+      static_assert(isLeafPowerNode<PowerNode>(), "LeafBatch requires a power node with leaf children");
+
+      static constexpr bool hasStaticDegree = requires { index_constant<std::remove_const_t<PowerNode>::degree()>{}; };
+
+    public:
+
+      //! The type of the leaves in this batch, const if the power node is const.
+      using Leaf = std::conditional_t<std::is_const_v<PowerNode>,
+        const typename PowerNode::ChildType,
+        typename PowerNode::ChildType>;
+
+      explicit LeafBatch (PowerNode& node)
+        : _node(&node)
+      {}
+
+      //! The number of lanes (leaves) in this batch.
+      auto lanes () const
+      {
+        if constexpr (hasStaticDegree)
+          return StaticDegree<std::remove_const_t<PowerNode>>{};
+        else
+          return std::size_t(_node->degree());
+      }
+
+      //! Returns the leaf in lane l.
+      Leaf& operator[] (std::size_t l) const
+      {
+        return _node->child(l);
+      }
+
+      //! Returns the power node holding the leaves of this batch.
+      PowerNode& node () const
+      {
+        return *_node;
+      }
+
+    private:
+      PowerNode* _node;
+    };
+
+    //! The number of lanes (leaves) in the batch.
+    template<class PowerNode>
+    auto lanes (const LeafBatch<PowerNode>& batch)
+    {
+      return batch.lanes();
+    }
+
+    //! Returns the leaf in lane l of the batch.
+    template<class PowerNode>
+    auto& lane (std::size_t l, const LeafBatch<PowerNode>& batch)
+    {
+      return batch[l];
+    }
+
+#ifndef DOXYGEN
+
+    namespace Detail {
+
+      template<class T, class TreePath, class BatchFunc, class LeafFunc>
+      auto forEachLeafBatch(T&& tree, TreePath treePath, BatchFunc&& batchFunc, LeafFunc&& leafFunc)
+      {
+        using Tree = std::decay_t<T>;
+        if constexpr(Tree::isLeaf) {
+          return invokeCallback([&]{ return leafFunc(tree, treePath); });
+        } else if constexpr(isLeafPowerNode<Tree>()) {
+          return invokeCallback([&]{ return batchFunc(LeafBatch<std::remove_reference_t<T>>(tree), treePath); });
+        } else {
+          // check which type of traversal is supported by the tree, prefer dynamic traversal
+          constexpr bool allowDynamicTraversal = DynamicTraversable<Tree>;
+          constexpr bool allowStaticTraversal = StaticTraversable<Tree>;
+
+          // the tree must support either dynamic or static traversal
+          static_assert(allowDynamicTraversal || allowStaticTraversal);
+
+          auto indices = [&]{
+            if constexpr(allowDynamicTraversal)
+              return std::size_t(tree.degree());
+            else
+              return std::make_index_sequence<Tree::degree()>{};
+          }();
+
+          return forEachIndexUntil(indices, [&](auto i) {
+            auto childTreePath = Dune::TypeTree::push_back(treePath, i);
+            return forEachLeafBatch(tree.child(i), childTreePath, batchFunc, leafFunc);
+          });
+        }
+      }
+
+    } // namespace Detail
+
+#endif // DOXYGEN
+
+    /**
+     * \brief Traverse tree and visit the leaf nodes in batches
+     *
+     * All leaf children of a power node are passed to batchFunc at once, bundled
+     * into a LeafBatch. The tree path passed along with the batch refers to the
+     * power node, the tree path of the leaf in lane `l` is `push_back(treePath, l)`.
+     * Leaf nodes which are not the child of a power node are passed to leafFunc
+     * individually, along with their own tree path.
+     *
+     * Both callbacks may return a TraversalStatus. Returning TraversalStatus::stop
+     * ends the traversal immediately.
+     *
+     * \param tree      The tree to traverse
+     * \param batchFunc This function is called with a LeafBatch and a tree path for
+     *                  each power node with leaf children
+     * \param leafFunc  This function is called for all other leaf nodes
+     */
+    template<class Tree, class BatchFunc, class LeafFunc>
+    void forEachLeafBatch(Tree&& tree, BatchFunc&& batchFunc, LeafFunc&& leafFunc)
+    {
+      Detail::forEachLeafBatch(tree, hybridTreePath(), batchFunc, leafFunc);
+    }
+
+    //! The corresponding leaf nodes of a batch of identically shaped trees.
+    /**
+     * Lane `l` of a BatchedLeafNodes object is the leaf at the position `treePath()`
+     * within the `l`-th tree. The object refers to the leaves that have been looked up
+     * by the traversal, so accessing a lane does not descend the tree again. It is
+     * only valid during the call of the callback it is passed to.
+     *
+     * Like LeafBatch, BatchedLeafNodes supports the free functions `lanes()` and `lane()`.
+     *
+     * \tparam Leaf     The (possibly const) type of the leaves.
+     * \tparam TreePath The type of the tree path of the leaves.
+     */
+    template<class Leaf, class TreePath>
+    class BatchedLeafNodes
+    {
+    public:
+
+      /* The leaves are passed as type-erased pointers, as the traversal
+       * keeps the nodes of all levels of the trees in a single buffer.
+       */
+      BatchedLeafNodes (std::span<void* const> leaves, TreePath treePath)
+        : _leaves(leaves)
+        , _treePath(treePath)
+      {}
+
+      //! The number of lanes (trees) in this batch.
+      std::size_t lanes () const
+      {
+        return _leaves.size();
+      }
+
+      //! Returns the leaf in lane l, i.e. the leaf in the l-th tree.
+      Leaf& operator[] (std::size_t l) const
+      {
+        return *static_cast<Leaf*>(_leaves[l]);
+      }
+
+      //! The position of the leaves within their trees.
+      const TreePath& treePath () const
+      {
+        return _treePath;
+      }
+
+    private:
+      std::span<void* const> _leaves;
+      TreePath _treePath;
+    };
+
+    //! The number of lanes (trees) in the batch.
+    template<class Leaf, class TreePath>
+    std::size_t lanes (const BatchedLeafNodes<Leaf,TreePath>& batch)
+    {
+      return batch.lanes();
+    }
+
+    //! Returns the leaf in lane l of the batch.
+    template<class Leaf, class TreePath>
+    auto& lane (std::size_t l, const BatchedLeafNodes<Leaf,TreePath>& batch)
+    {
+      return batch[l];
+    }
+
+#ifndef DOXYGEN
+
+    namespace Detail {
+
+      // Type-erased pointer to a possibly const node
+      template<class Node>
+      void* nodePointer(Node& node)
+      {
+        return const_cast<void*>(static_cast<const void*>(std::addressof(node)));
+      }
+
+      /* Traverse the corresponding nodes of a batch of trees at once. The
+       * nodes of the current level are stored in the first `lanes` entries
+       * of `levels`, the following entries hold the nodes of the levels
+       * below. The children of all nodes are looked up once per child
+       * position and passed on to the traversal of the child, such that
+       * every node of every tree is only accessed from its parent.
+       */
+      template<class Node, class TreePath, class LeafFunc>
+      auto forEachLeafNodeBatched(std::span<void*> levels, std::size_t lanes, TreePath treePath, LeafFunc&& leafFunc)
+      {
+        auto nodes = levels.first(lanes);
+        auto node = [&](std::size_t k) -> Node& { return *static_cast<Node*>(nodes[k]); };
+
+        if constexpr(Node::isLeaf) {
+          return invokeCallback([&]{ return leafFunc(BatchedLeafNodes<Node,TreePath>(nodes, treePath), treePath); });
+        } else {
+          // check which type of traversal is supported by the tree, prefer dynamic traversal
+          constexpr bool allowDynamicTraversal = DynamicTraversable<Node>;
+          constexpr bool allowStaticTraversal = StaticTraversable<Node>;
+
+          // the tree must support either dynamic or static traversal
+          static_assert(allowDynamicTraversal || allowStaticTraversal);
+
+          auto children = levels.subspan(lanes);
+          auto visitChild = [&](auto i) {
+            for (std::size_t k = 0; k < lanes; ++k)
+              children[k] = nodePointer(node(k).child(i));
+            using Child = std::remove_reference_t<decltype(node(0).child(i))>;
+            auto childTreePath = Dune::TypeTree::push_back(treePath, i);
+            return forEachLeafNodeBatched<Child>(children, lanes, childTreePath, leafFunc);
+          };
+
+          if constexpr(allowDynamicTraversal) {
+            const std::size_t degree = node(0).degree();
+            for (std::size_t k = 1; k < lanes; ++k)
+              assert(std::size_t(node(k).degree()) == degree && "all trees of a batch must have the same shape");
+            return forEachIndexUntil(degree, visitChild);
+          } else {
+            return forEachIndexUntil(std::make_index_sequence<Node::degree()>{}, visitChild);
+          }
+        }
+      }
+
+    } // namespace Detail
+
+#endif // DOXYGEN
+
+    /**
+     * \brief Traverse a batch of identically shaped trees and visit their leaf nodes at once
+     *
+     * The structure of the trees is traversed only once, following the first tree.
+     * For each leaf, leafFunc is called with a BatchedLeafNodes object holding the
+     * corresponding leaves of all trees, and with their common tree path.
+     * The nodes of all trees are looked up level by level along the traversal, so
+     * the leaves of a batch are available without descending the trees again. This
+     * amortizes the traversal over the batch and allows to process the leaves of all
+     * trees together, e.g. vectorized across the trees. The looked up nodes are kept
+     * in a single buffer, which is allocated on the stack if the extent of `trees`
+     * is static.
+     *
+     * The traversal ends early if leafFunc returns TraversalStatus::stop.
+     *
+     * \note All trees must have the same shape, i.e. the nodes with run time degree
+     *       must have the same degree in all trees.
+     *
+     * \param trees    The trees to traverse
+     * \param leafFunc This function is called for each leaf position
+     */
+    template<class Tree, std::size_t extent, class LeafFunc>
+    void forEachLeafNodeBatched(std::span<Tree,extent> trees, LeafFunc&& leafFunc)
+    {
+      if (trees.empty())
+        return;
+
+      // the nodes of all trees on the current path, one slice of trees.size() entries per level
+      constexpr std::size_t depth = Detail::maxDepth<std::remove_const_t<Tree>>();
+      auto traverse = [&](std::span<void*> levels) {
+        for (std::size_t k = 0; k < trees.size(); ++k)
+          levels[k] = Detail::nodePointer(trees[k]);
+        Detail::forEachLeafNodeBatched<Tree>(levels, trees.size(), hybridTreePath(), leafFunc);
+      };
+
+      if constexpr(extent != std::dynamic_extent) {
+        std::array<void*, depth*extent> levels;
+        traverse(levels);
+      } else {
+        std::vector<void*> levels(depth*trees.size());
+        traverse(levels);
+      }
+    }
+
+    //! \} group Tree Traversal
+
+  } // namespace TypeTree
+} //namespace Dune
+
+#endif // DUNE_TYPETREE_LEAFBATCH_HH
@@ -0,0 +1,286 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+
+#ifndef DUNE_TYPETREE_LEAFRANGE_HH
+#define DUNE_TYPETREE_LEAFRANGE_HH
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include <dune/common/indices.hh>
+
+#include <dune/typetree/treepath.hh>
+
+namespace Dune {
+  namespace TypeTree {
+
+    /** \addtogroup Tree Traversal
+     *  \ingroup TypeTree
+     *  \{
+     */
+
+#ifndef DOXYGEN
+
+    namespace Detail {
+
+      // Number of levels of power nodes with dynamic child access above the leafs
+      // of Node, or -1 if the subtree contains any other kind of inner node
+      template<class Node>
+      constexpr int dynamicPowerChainDepth()
+      {
+        if constexpr (Node::isLeaf)
+          return 0;
+        else if constexpr (Node::isPower and requires (Node& node) { node.child(std::size_t(0)); }) {
+          using Child = std::remove_reference_t<decltype(std::declval<Node&>().child(std::size_t(0)))>;
+          constexpr int childDepth = dynamicPowerChainDepth<Child>();
+          return childDepth < 0 ? -1 : 1 + childDepth;
+        }
+        else
+          return -1;
+      }
+
+      /* The position of a leaf within the subtree rooted in a node. Each
+       * cursor stores the index of the current child and a cursor into
+       * this child, such that the state of a whole traversal is stored
+       * in a fixed-size object without any heap allocation.
+       */
+      template<class Node, bool isLeaf = Node::isLeaf>
+      class LeafCursor
+      {
+        using Child = std::remove_reference_t<decltype(std::declval<Node&>().child(std::size_t(0)))>;
+
+      public:
+
+        using Leaf = typename LeafCursor<Child>::Leaf;
+
+        // move to the first leaf of node, returns false if there is none
+        bool first (Node& node)
+        {
+          _node = &node;
+          for (_index = 0; _index < std::size_t(node.degree()); ++_index)
+            if (_child.first(node.child(_index)))
+              return true;
+          return false;
+        }
+
+        // move to the next leaf, returns false if there is none
+        bool next ()
+        {
+          if (_child.next())
+            return true;
+          for (++_index; _index < std::size_t(_node->degree()); ++_index)
+            if (_child.first(_node->child(_index)))
+              return true;
+          return false;
+        }
+
+        Leaf& leaf () const
+        {
+          return _child.leaf();
+        }
+
+        template<std::size_t n>
+        void treePath (std::array<std::size_t,n>& indices, std::size_t level) const
+        {
+          indices[level] = _index;
+          _child.treePath(indices, level+1);
+        }
+
+      private:
+        Node* _node = nullptr;
+        std::size_t _index = 0;
+        LeafCursor<Child> _child;
+      };
+
+      template<class Node>
+      class LeafCursor<Node,true>
+      {
+      public:
+
+        using Leaf = Node;
+
+        bool first (Node& node)
+        {
+          _node = &node;
+          return true;
+        }
+
+        bool next ()
+        {
+          return false;
+        }
+
+        Leaf& leaf () const
+        {
+          return *_node;
+        }
+
+        template<std::size_t n>
+        void treePath (std::array<std::size_t,n>&, std::size_t) const
+        {}
+
+      private:
+        Node* _node = nullptr;
+      };
+
+    } // namespace Detail
+
+#endif // DOXYGEN
+
+    //! A range over the leaf nodes of a tree, which can be iterated lazily.
+    /**
+     * In contrast to forEachLeafNode(), which calls a function for every leaf,
+     * the leafs are produced one by one on demand by an iterator. Hence, an
+     * iteration may be stopped at any point with `break`, several iterations
+     * may be interleaved, and the range can be combined with the algorithms
+     * and views of `std::ranges`.
+     *
+     * The range is available for trees made of nested power nodes with dynamic
+     * child access (like PowerNode, DynamicPowerNode and DynamicFilteredNode),
+     * i.e. trees that can be traversed with tree paths consisting of run time
+     * indices only. All leafs of such a tree have the same type. Inner nodes
+     * without any children are skipped.
+     *
+     * The iterator stores the position of the current leaf on every level of the
+     * tree. It does not allocate memory and is cheap to copy and to advance.
+     *
+     * \tparam Tree The (possibly const) type of the tree.
+     */
+    template<class Tree>
+    class LeafRange
+    {
+      static constexpr int depth = Detail::dynamicPowerChainDepth<std::remove_const_t<Tree>>();
+
+      static_assert(depth >= 0, "LeafRange requires a tree of power nodes with dynamic child access");
+
+      using Cursor = Detail::LeafCursor<Tree>;
+
+    public:
+
+      //! The type of the leaf nodes, const if the tree is const.
+      using Leaf = typename Cursor::Leaf;
+
+      //! The type of the tree paths of the leaf nodes.
+      using TreePath = decltype(unpackIntegerSequence([](auto... i) {
+        return hybridTreePath((std::size_t(i))...);
+      }, std::make_index_sequence<depth>{}));
+
+      //! Forward iterator over the leaf nodes.
+      class Iterator
+      {
+      public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_const_t<Leaf>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Leaf*;
+        using reference = Leaf&;
+
+        //! Creates an iterator past the last leaf.
+        Iterator () = default;
+
+        //! Creates an iterator to the first leaf of tree.
+        explicit Iterator (Tree& tree)
+          : _valid(_cursor.first(tree))
+        {}
+
+        reference operator* () const
+        {
+          return _cursor.leaf();
+        }
+
+        pointer operator-> () const
+        {
+          return &_cursor.leaf();
+        }
+
+        Iterator& operator++ ()
+        {
+          _valid = _cursor.next();
+          return *this;
+        }
+
+        Iterator operator++ (int)
+        {
+          Iterator copy = *this;
+          ++*this;
+          return copy;
+        }
+
+        //! The tree path of the current leaf.
+        TreePath treePath () const
+        {
+          std::array<std::size_t,depth> indices;
+          _cursor.treePath(indices, 0);
+          return unpackIntegerSequence([&](auto... i) {
+            return hybridTreePath(indices[i]...);
+          }, std::make_index_sequence<depth>{});
+        }
+
+        friend bool operator== (const Iterator& lhs, const Iterator& rhs)
+        {
+          if (lhs._valid != rhs._valid)
+            return false;
+          return not lhs._valid or lhs.treePath() == rhs.treePath();
+        }
+
+        friend bool operator== (const Iterator& it, std::default_sentinel_t)
+        {
+          return not it._valid;
+        }
+
+      private:
+        Cursor _cursor;
+        bool _valid = false;
+      };
+
+      explicit LeafRange (Tree& tree)
+        : _tree(&tree)
+      {}
+
+      Iterator begin () const
+      {
+        return Iterator(*_tree);
+      }
+
+      std::default_sentinel_t end () const
+      {
+        return {};
+      }
+
+    private:
+      Tree* _tree;
+    };
+
+    //! Returns a range over the leaf nodes of a tree of power nodes.
+    /**
+     * \code{.cc}
+     * // find the first leaf satisfying some condition
+     * for (auto&& leaf : leaves(tree))
+     *   if (condition(leaf))
+     *     break;
+     *
+     * // the tree path of the current leaf is available from the iterator
+     * for (auto it = leaves(tree).begin(); it != std::default_sentinel; ++it)
+     *   std::cout << it.treePath() << std::endl;
+     * \endcode
+     *
+     * \sa LeafRange
+     */
+    template<class Tree>
+    LeafRange<Tree> leaves (Tree& tree)
+    {
+      return LeafRange<Tree>(tree);
+    }
+
+    //! \} group Tree Traversal
+
+  } // namespace TypeTree
+} //namespace Dune
+
+#endif // DUNE_TYPETREE_LEAFRANGE_HH
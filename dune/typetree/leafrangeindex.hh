@@ -0,0 +1,254 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+
+#ifndef DUNE_TYPETREE_LEAFRANGEINDEX_HH
+#define DUNE_TYPETREE_LEAFRANGEINDEX_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include <dune/common/hybridutilities.hh>
+
+#include <dune/typetree/dynamictreepath.hh>
+#include <dune/typetree/traversal.hh>
+#include <dune/typetree/treepath.hh>
+
+namespace Dune {
+  namespace TypeTree {
+
+    /** \addtogroup Tree Traversal
+     *  \ingroup TypeTree
+     *  \{
+     */
+
+    //! Maps a flat index into the concatenated index ranges of the leafs of a tree.
+    /**
+     * Each leaf of the tree owns a contiguous range of flat indices, whose size is
+     * given by a user-provided functor, e.g. the number of local degrees of freedom.
+     * The ranges of the leafs are concatenated in the order of forEachLeafNode().
+     * A LeafRangeIndex stores the offsets of these ranges, collected in a single
+     * traversal, and answers which leaf owns a given flat index:
+     *
+     * \code{.cc}
+     * LeafRangeIndex index(tree, [](auto&& leaf) { return leaf.finiteElement().size(); });
+     * auto [leaf, localIndex] = index.position(k);
+     * applyToChild(tree, index.treePath(leaf), [&](auto&& node) { ... });
+     * \endcode
+     *
+     * The lookup is a binary search over the offsets, which takes O(log n) steps
+     * for n leafs. If all leafs have the same nonzero size, as it is usually the
+     * case for trees of power nodes, the lookup is a single division instead.
+     *
+     * The index refers to the shape of the tree at the time of its construction.
+     * If the degree of a node with dynamic degree (like DynamicPowerNode or
+     * DynamicFilteredNode) changes, the index is invalidated, which can be
+     * detected by isValid(). update() then recomputes the part of the index
+     * belonging to the changed subtree, without visiting the rest of the tree.
+     *
+     * \tparam Tree The type of the tree.
+     */
+    template<class Tree>
+    class LeafRangeIndex
+    {
+
+      // A node with dynamic degree and the degree it had when it was indexed
+      struct NodeDegree
+      {
+        DynamicTreePath treePath;
+        std::size_t degree;
+      };
+
+    public:
+
+      //! The position of a flat index within the range of its leaf.
+      struct Position
+      {
+        std::size_t leaf;       //!< The number of the leaf in traversal order.
+        std::size_t localIndex; //!< The position of the flat index within the range of the leaf.
+      };
+
+      //! Build the index for tree, with `leafSize(leaf)` flat indices per leaf.
+      template<class LeafSize>
+      LeafRangeIndex (const Tree& tree, LeafSize&& leafSize)
+      {
+        rebuild(tree, leafSize);
+      }
+
+      //! Build the index again from scratch.
+      template<class LeafSize>
+      void rebuild (const Tree& tree, LeafSize&& leafSize)
+      {
+        std::vector<std::size_t> sizes;
+        _treePaths.clear();
+        _dynamicNodes.clear();
+        collect(tree, DynamicTreePath(), leafSize, _treePaths, sizes, _dynamicNodes);
+        _offsets.assign(1, 0);
+        for (auto size : sizes)
+          _offsets.push_back(_offsets.back() + size);
+        updateUniformSize();
+      }
+
+      //! Update the index after the shape of the subtree at treePath has changed.
+      /**
+       * Only the subtree at treePath is traversed and only its leafs are passed to
+       * `leafSize`. The ranges of the leafs behind the subtree are shifted.
+       *
+       * \note The ancestors of the subtree must have kept their degrees, i.e. treePath
+       *       must refer to the outermost node whose degree has changed (or one of its
+       *       ancestors).
+       */
+      template<class LeafSize>
+      void update (const Tree& tree, const DynamicTreePath& treePath, LeafSize&& leafSize)
+      {
+        std::vector<DynamicTreePath> treePaths;
+        std::vector<std::size_t> sizes;
+        std::vector<NodeDegree> dynamicNodes;
+        applyToChild(tree, treePath, [&](auto&& node) {
+          collect(node, treePath, leafSize, treePaths, sizes, dynamicNodes);
+        });
+
+        // the traversal order is the lexicographic order of the tree paths,
+        // so the old entries of the subtree form a contiguous range
+        auto inSubtree = [&](const DynamicTreePath& tp) {
+          return tp.size() >= treePath.size() and std::equal(treePath.begin(), treePath.end(), tp.begin());
+        };
+
+        auto firstLeaf = std::lower_bound(_treePaths.begin(), _treePaths.end(), treePath);
+        auto lastLeaf = std::find_if_not(firstLeaf, _treePaths.end(), inSubtree);
+        std::size_t first = firstLeaf - _treePaths.begin();
+        std::size_t last = lastLeaf - _treePaths.begin();
+
+        std::vector<std::size_t> offsets(_offsets.begin(), _offsets.begin() + first + 1);
+        for (auto size : sizes)
+          offsets.push_back(offsets.back() + size);
+        for (std::size_t i = last; i < leafCount(); ++i)
+          offsets.push_back(offsets.back() + _offsets[i+1] - _offsets[i]);
+        _offsets = std::move(offsets);
+        _treePaths.erase(firstLeaf, lastLeaf);
+        _treePaths.insert(_treePaths.begin() + first, treePaths.begin(), treePaths.end());
+
+        auto firstNode = std::lower_bound(_dynamicNodes.begin(), _dynamicNodes.end(), treePath,
+          [](const NodeDegree& node, const DynamicTreePath& tp) { return node.treePath < tp; });
+        auto lastNode = std::find_if_not(firstNode, _dynamicNodes.end(),
+          [&](const NodeDegree& node) { return inSubtree(node.treePath); });
+        auto pos = _dynamicNodes.erase(firstNode, lastNode);
+        _dynamicNodes.insert(pos, dynamicNodes.begin(), dynamicNodes.end());
+
+        updateUniformSize();
+      }
+
+      //! Check whether all nodes with dynamic degree still have the degree they had when they were indexed.
+      /**
+       * \note Changes of the leaf sizes cannot be detected, as they are not part of the tree.
+       */
+      bool isValid (const Tree& tree) const
+      {
+        // ancestors are checked first, so all visited paths exist in the tree
+        for (const auto& [treePath, degree] : _dynamicNodes)
+        {
+          bool valid = false;
+          applyToChild(tree, treePath, [&](auto&& node) {
+            valid = (std::size_t(node.degree()) == degree);
+          });
+          if (not valid)
+            return false;
+        }
+        return true;
+      }
+
+      //! The total number of flat indices.
+      std::size_t size () const
+      {
+        return _offsets.back();
+      }
+
+      //! The number of leafs.
+      std::size_t leafCount () const
+      {
+        return _treePaths.size();
+      }
+
+      //! The first flat index of the given leaf.
+      std::size_t offset (std::size_t leaf) const
+      {
+        assert(leaf < leafCount());
+        return _offsets[leaf];
+      }
+
+      //! The number of flat indices of the given leaf.
+      std::size_t leafSize (std::size_t leaf) const
+      {
+        assert(leaf < leafCount());
+        return _offsets[leaf+1] - _offsets[leaf];
+      }
+
+      //! The path of the given leaf within the tree.
+      const DynamicTreePath& treePath (std::size_t leaf) const
+      {
+        assert(leaf < leafCount());
+        return _treePaths[leaf];
+      }
+
+      //! Find the leaf owning the given flat index and the position of the index within its range.
+      Position position (std::size_t index) const
+      {
+        assert(index < size());
+        if (_uniformSize > 0)
+          return {index / _uniformSize, index % _uniformSize};
+
+        // the last leaf starting at or before index, leafs with empty ranges are skipped
+        std::size_t leaf = std::upper_bound(_offsets.begin(), _offsets.end(), index) - _offsets.begin() - 1;
+        return {leaf, index - _offsets[leaf]};
+      }
+
+    private:
+
+      template<class Node, class LeafSize>
+      static void collect (const Node& node, const DynamicTreePath& prefix, LeafSize& leafSize,
+        std::vector<DynamicTreePath>& treePaths, std::vector<std::size_t>& sizes, std::vector<NodeDegree>& dynamicNodes)
+      {
+        auto join = [&](auto tp) {
+          DynamicTreePath treePath = prefix;
+          Dune::Hybrid::forEach(tp, [&](auto i) {
+            treePath.push_back(i);
+          });
+          return treePath;
+        };
+
+        forEachNode(node,
+          [&](auto&& inner, auto tp) {
+            using Inner = std::decay_t<decltype(inner)>;
+            if constexpr(not Detail::StaticTraversable<Inner>)
+              dynamicNodes.push_back({join(tp), std::size_t(inner.degree())});
+          },
+          [&](auto&& leaf, auto tp) {
+            treePaths.push_back(join(tp));
+            sizes.push_back(leafSize(leaf));
+          },
+          NoOp{});
+      }
+
+      void updateUniformSize ()
+      {
+        _uniformSize = leafCount() > 0 ? leafSize(0) : 0;
+        for (std::size_t leaf = 1; leaf < leafCount() and _uniformSize > 0; ++leaf)
+          if (leafSize(leaf) != _uniformSize)
+            _uniformSize = 0;
+      }
+
+      std::vector<DynamicTreePath> _treePaths;
+      std::vector<std::size_t> _offsets = {0};
+      std::vector<NodeDegree> _dynamicNodes;
+      std::size_t _uniformSize = 0;
+    };
+
+    //! \} group Tree Traversal
+
+  } // namespace TypeTree
+} //namespace Dune
+
+#endif // DUNE_TYPETREE_LEAFRANGEINDEX_HH
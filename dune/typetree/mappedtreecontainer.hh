@@ -0,0 +1,227 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+
+#ifndef DUNE_TYPETREE_MAPPEDTREECONTAINER_HH
+#define DUNE_TYPETREE_MAPPEDTREECONTAINER_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/typetree/exceptions.hh>
+#include <dune/typetree/serialization.hh>
+#include <dune/typetree/treecontainer.hh>
+#include <dune/typetree/treepath.hh>
+
+// Memory mapping of files is only available on POSIX systems
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Dune {
+  namespace TypeTree {
+
+#ifndef DOXYGEN
+
+    namespace Detail {
+
+      /*
+       * \brief Read-only access to the leaf values stored in a memory-mapped file
+       *
+       * The file is mapped as a whole, but the operating system only reads the
+       * pages that are actually accessed. The position of each leaf within the
+       * mapped values is looked up in the Indexer, like in FlatTreeContainer.
+       */
+      template<class Value, class Indexer>
+      class MappedTreeContainer
+      {
+        static_assert(std::is_trivially_copyable_v<Value>,
+          "Only trivially copyable values can be accessed in a memory-mapped file");
+        static_assert(alignof(Value) <= alignof(std::uint64_t),
+          "The values in the file are only aligned to 8 bytes");
+
+      public:
+
+        //! Map the file written by writeTreeContainer() for the given tree
+        template<class Tree>
+        MappedTreeContainer(const std::string& fileName, const Tree& tree) :
+          indexer_(tree)
+        {
+          size_ = enumerateLeafs(indexer_, tree);
+          auto header = serializationHeader(tree, *this);
+          const std::size_t headerSize = serializationMagic.size() + header.size() * sizeof(std::uint64_t);
+
+          int fd = ::open(fileName.c_str(), O_RDONLY);
+          if (fd < 0)
+            DUNE_THROW(Dune::IOError, "Could not open tree container file " << fileName);
+          struct stat status;
+          if (::fstat(fd, &status) != 0) {
+            ::close(fd);
+            DUNE_THROW(Dune::IOError, "Could not determine the size of tree container file " << fileName);
+          }
+          mappedSize_ = status.st_size;
+          if (mappedSize_ > 0)
+            mapped_ = ::mmap(nullptr, mappedSize_, PROT_READ, MAP_PRIVATE, fd, 0);
+          // the mapping stays valid after closing the file
+          ::close(fd);
+          if (mapped_ == MAP_FAILED) {
+            mapped_ = nullptr;
+            DUNE_THROW(Dune::IOError, "Could not map tree container file " << fileName);
+          }
+
+          const char* bytes = static_cast<const char*>(mapped_);
+          if (mappedSize_ < headerSize or std::memcmp(bytes, serializationMagic.data(), serializationMagic.size()) != 0
+            or std::memcmp(bytes + serializationMagic.size(), header.data(), header.size() * sizeof(std::uint64_t)) != 0) {
+            unmap();
+            DUNE_THROW(Dune::TypeTree::Exception, "File " << fileName << " does not contain a tree container matching the tree and value size");
+          }
+          if (mappedSize_ < headerSize + size_ * sizeof(Value)) {
+            unmap();
+            DUNE_THROW(Dune::IOError, "Tree container file " << fileName << " is truncated");
+          }
+          values_ = reinterpret_cast<const Value*>(bytes + headerSize);
+        }
+
+        MappedTreeContainer(const MappedTreeContainer&) = delete;
+        MappedTreeContainer& operator=(const MappedTreeContainer&) = delete;
+
+        MappedTreeContainer(MappedTreeContainer&& other) :
+          indexer_(std::move(other.indexer_)),
+          mapped_(std::exchange(other.mapped_, nullptr)),
+          mappedSize_(std::exchange(other.mappedSize_, 0)),
+          values_(std::exchange(other.values_, nullptr)),
+          size_(std::exchange(other.size_, 0))
+        {}
+
+        MappedTreeContainer& operator=(MappedTreeContainer&& other)
+        {
+          if (this == &other)
+            return *this;
+          unmap();
+          indexer_ = std::move(other.indexer_);
+          mapped_ = std::exchange(other.mapped_, nullptr);
+          mappedSize_ = std::exchange(other.mappedSize_, 0);
+          values_ = std::exchange(other.values_, nullptr);
+          size_ = std::exchange(other.size_, 0);
+          return *this;
+        }
+
+        ~MappedTreeContainer()
+        {
+          unmap();
+        }
+
+        template<class... T>
+        const Value& operator[](const HybridTreePath<T...>& path) const
+        {
+          return values_[indexer_[path]];
+        }
+
+        //! The position of the value of the leaf at the given path within values()
+        template<class... T>
+        std::size_t index(const HybridTreePath<T...>& path) const
+        {
+          return indexer_[path];
+        }
+
+        //! The number of leafs
+        std::size_t size() const
+        {
+          return size_;
+        }
+
+        //! The values of all leafs in the mapped file
+        std::span<const Value> values() const
+        {
+          return {values_, size_};
+        }
+
+        const Indexer& indexer() const
+        {
+          return indexer_;
+        }
+
+      private:
+
+        void unmap()
+        {
+          if (mapped_)
+            ::munmap(mapped_, mappedSize_);
+          mapped_ = nullptr;
+        }
+
+        Indexer indexer_;
+        void* mapped_ = nullptr;
+        std::size_t mappedSize_ = 0;
+        const Value* values_ = nullptr;
+        std::size_t size_ = 0;
+      };
+
+    } // namespace Detail
+
+#endif // DOXYGEN
+
+    /** \addtogroup TypeTree
+     *  \{
+     */
+
+    /**
+     * \brief Access the leaf values stored in a file without reading the file
+     *
+     * \code
+     #include <dune/typetree/mappedtreecontainer.hh>
+     * \endcode
+     * The file must have been written by writeTreeContainer() for a tree of the same
+     * shape with values of type Value, e.g. from a container created by
+     * makeFlatTreeContainer<Value>(tree). The file is mapped into memory read-only, so
+     * creating the container neither copies nor reads the values: only the pages holding
+     * the values that are actually accessed are loaded by the operating system.
+     *
+     * The returned object provides read-only operator[] access using a HybridTreePath,
+     * like the container created by makeTreeContainer, and access to all values as a
+     * std::span by values().
+     *
+     * \note This function is only available on POSIX systems, i.e. if the header
+     *       `<sys/mman.h>` exists. Otherwise, including this header has no effect.
+     *
+     * \tparam Value Type of the values stored for the leafs. Must be trivially copyable.
+     * \param fileName The name of the file written by writeTreeContainer()
+     * \param tree The tree the file was written for
+     *
+     * \throws Dune::TypeTree::Exception if the file does not match the tree or the size of Value.
+     * \throws Dune::IOError if the file cannot be opened or mapped, or if it is truncated.
+     *
+     * \returns A read-only container for the leafs of the tree
+     */
+    template<class Value, class Tree>
+    auto makeMappedTreeContainer(const std::string& fileName, const Tree& tree)
+    {
+      using Indexer = std::decay_t<decltype(makeTreeContainer<std::size_t>(tree))>;
+      return Detail::MappedTreeContainer<Value,Indexer>(fileName, tree);
+    }
+
+    /**
+     * \brief Alias to container type generated by makeMappedTreeContainer for given tree type and value type
+     */
+    template<class Value, class Tree>
+    using MappedTreeContainer = std::decay_t<decltype(makeMappedTreeContainer<Value>(std::declval<const std::string&>(), std::declval<const Tree&>()))>;
+
+    //! \} group TypeTree
+
+  } // namespace TypeTree
+} //namespace Dune
+
+#endif // __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+
+#endif // DUNE_TYPETREE_MAPPEDTREECONTAINER_HH
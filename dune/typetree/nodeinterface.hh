@@ -30,6 +30,15 @@ namespace Dune {
      *       the node base classes LeafNode, PowerNode, DynamicPowerNodeTag, or
      *       CompositeNode, or from a base class for a yet-to-be-defined new
      *       node type.
+     *
+     * \par Concurrent read-only access
+     * The child() methods of the node types provided by this module return plain
+     * references and do not copy the stored (shared) pointers. Neither do the tree
+     * traversal algorithms (forEachNode(), forEachLeafNode(), applyToTree(), ...) and
+     * the free function child(). Hence, a tree that is not modified can be traversed
+     * by several threads at the same time, e.g. via a const reference, without any
+     * reference count being modified. Only the childStorage() methods and the free
+     * function childStorage() hand out copies of the owning pointers.
      */
     struct NodeInterface
     {
@@ -0,0 +1,371 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+
+#ifndef DUNE_TYPETREE_NODEMAP_HH
+#define DUNE_TYPETREE_NODEMAP_HH
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/hybridutilities.hh>
+#include <dune/common/indices.hh>
+#include <dune/common/rangeutilities.hh>
+#include <dune/common/typetraits.hh>
+
+#include <dune/typetree/nodeinterface.hh>
+#include <dune/typetree/shapehash.hh>
+#include <dune/typetree/treepath.hh>
+
+namespace Dune {
+  namespace TypeTree {
+
+    /** \addtogroup TypeTree
+     *  \{
+     */
+
+#ifndef DOXYGEN
+
+    namespace Detail {
+
+      template<class Node, class Index>
+      using ChildTypeAt = std::decay_t<decltype(std::declval<const Node&>().child(std::declval<Index>()))>;
+
+      // Whether the shape of the tree, and thus the ids of all its nodes, are known at compile time
+      template<class Tree>
+      inline constexpr bool hasStaticNodeIds = not hasDynamicShape<Tree>();
+
+      template<class Node>
+      constexpr std::size_t staticNodeCount()
+      {
+        if constexpr (Node::isLeaf)
+          return 1;
+        else if constexpr (Node::isPower)
+          // exploit the fact that all children are identical
+          return 1 + StaticDegree<Node>::value * staticNodeCount<typename Node::ChildType>();
+        else
+          return unpackIntegerSequence([](auto... k) {
+            return (std::size_t(1) + ... + staticNodeCount<StaticChildType<Node,k>>());
+          }, std::make_index_sequence<StaticDegree<Node>::value>{});
+      }
+
+      // Offset of the id of child k relative to the id of node
+      template<class Node, class Index>
+      constexpr std::size_t staticChildOffset(Index k)
+      {
+        if constexpr (Node::isPower)
+          return 1 + std::size_t(k) * staticNodeCount<typename Node::ChildType>();
+        else
+        {
+          static_assert(IsIntegralConstant<Index>::value,
+            "The children of composite nodes must be addressed by compile time indices");
+          return unpackIntegerSequence([](auto... j) {
+            return (std::size_t(1) + ... + staticNodeCount<StaticChildType<Node,j>>());
+          }, std::make_index_sequence<Index::value>{});
+        }
+      }
+
+      // Id of the node at the entries i, i+1, ... of path, relative to the id of node
+      template<class Node, class Path, std::size_t i = 0>
+      constexpr std::size_t staticNodeId(const Path& path, index_constant<i> = {})
+      {
+        if constexpr (i == Path::size())
+          return 0;
+        else
+        {
+          auto k = path[index_constant<i>{}];
+          return staticChildOffset<Node>(k)
+            + staticNodeId<ChildTypeAt<Node,decltype(k)>>(path, index_constant<i+1>{});
+        }
+      }
+
+      template<class Value, std::size_t size>
+      void assignNodeValues(std::array<Value,size>& values, std::size_t, const Value& value)
+      {
+        values.fill(value);
+      }
+
+      template<class Value>
+      void assignNodeValues(std::vector<Value>& values, std::size_t size, const Value& value)
+      {
+        values.assign(size, value);
+      }
+
+    } // namespace Detail
+
+#endif // DOXYGEN
+
+    //! The number of nodes of a tree whose shape is known at compile time.
+    /**
+     * \code
+     #include <dune/typetree/nodemap.hh>
+     * \endcode
+     * \tparam Tree The type of the tree, which must not contain nodes with dynamic degree.
+     */
+    template<class Tree>
+    constexpr std::size_t nodeCount()
+    {
+      static_assert(Detail::hasStaticNodeIds<Tree>,
+        "nodeCount<Tree>() requires a tree without nodes of dynamic degree, use NodeIds instead");
+      return Detail::staticNodeCount<Tree>();
+    }
+
+    //! The id of the node at the given path in a tree whose shape is known at compile time.
+    /**
+     * \code
+     #include <dune/typetree/nodemap.hh>
+     * \endcode
+     * The nodes of a tree are numbered consecutively from 0 to nodeCount<Tree>()-1 in
+     * depth-first pre-order, i.e. the root has id 0 and every node has a smaller id than
+     * its children, like in forEachNode(). If the path consists of compile time indices
+     * only, the id is a compile time constant. Children of power nodes may also be
+     * addressed by run time indices, in which case the id is computed by a few
+     * multiplications and additions.
+     *
+     * \tparam Tree The type of the tree, which must not contain nodes with dynamic degree.
+     * \param path The path of the node within the tree.
+     */
+    template<class Tree, class... T>
+    constexpr std::size_t nodeId(const HybridTreePath<T...>& path)
+    {
+      static_assert(Detail::hasStaticNodeIds<Tree>,
+        "nodeId<Tree>(path) requires a tree without nodes of dynamic degree, use NodeIds instead");
+      return Detail::staticNodeId<Tree>(path);
+    }
+
+    //! Dense ids of the nodes of a tree.
+    /**
+     * \code
+     #include <dune/typetree/nodemap.hh>
+     * \endcode
+     * The nodes are numbered consecutively from 0 to size()-1 in depth-first pre-order,
+     * like in forEachNode(). For trees without nodes of dynamic degree, the ids are given
+     * by nodeId<Tree>(path), NodeIds stores nothing and all member functions are constexpr.
+     *
+     * If the tree contains nodes of dynamic degree, the ids are computed once by a
+     * single traversal of the tree. For every node whose subtree contains a node of
+     * dynamic degree, the ids of its children are stored, such that the id of a node
+     * is found by one table lookup per entry of its path. Subtrees of static shape are
+     * not traversed and their ids are computed like by nodeId<Tree>(path).
+     *
+     * The ids refer to the shape of the tree at the time of their construction. After
+     * a change of the degree of a node, the ids have to be computed again by update().
+     *
+     * \tparam Tree The type of the tree.
+     */
+    template<class Tree>
+    class NodeIds
+    {
+    public:
+
+      //! Whether the ids are known at compile time.
+      static constexpr bool isStatic = Detail::hasStaticNodeIds<Tree>;
+
+      //! Default constructor, only available for trees whose shape is known at compile time.
+      constexpr NodeIds () requires isStatic = default;
+
+      //! Compute the ids of the nodes of tree.
+      constexpr explicit NodeIds (const Tree& tree)
+      {
+        update(tree);
+      }
+
+      //! Compute the ids again, after the degree of a node has changed.
+      constexpr void update (const Tree& tree)
+      {
+        if constexpr (not isStatic)
+        {
+          _childIds.clear();
+          _firstChild.clear();
+          _size = collect(tree, 0);
+        }
+      }
+
+      //! The number of nodes.
+      constexpr std::size_t size () const
+      {
+        if constexpr (isStatic)
+          return nodeCount<Tree>();
+        else
+          return _size;
+      }
+
+      //! The id of the node at the given path.
+      template<class... T>
+      constexpr std::size_t operator[] (const HybridTreePath<T...>& path) const
+      {
+        if constexpr (isStatic)
+          return nodeId<Tree>(path);
+        else
+          return lookup<Tree>(0, path, Indices::_0);
+      }
+
+    private:
+
+      // Number the nodes of the subtree of node, starting with id for node itself
+      template<class Node>
+      std::size_t collect (const Node& node, std::size_t id)
+      {
+        if constexpr (Detail::hasStaticNodeIds<Node>)
+          return Detail::staticNodeCount<Node>();
+        else
+        {
+          std::size_t first = _childIds.size();
+          if (_firstChild.size() <= id)
+            _firstChild.resize(id + 1);
+          _firstChild[id] = first;
+          _childIds.resize(first + node.degree());
+
+          std::size_t next = id + 1;
+          Dune::Hybrid::forEach(Dune::range(node.degree()), [&](auto k) {
+            _childIds[first + k] = next;
+            next += collect(node.child(k), next);
+          });
+          return next - id;
+        }
+      }
+
+      template<class Node, class Path, std::size_t i>
+      std::size_t lookup (std::size_t id, const Path& path, index_constant<i>) const
+      {
+        if constexpr (i == Path::size())
+          return id;
+        else if constexpr (Detail::hasStaticNodeIds<Node>)
+          return id + Detail::staticNodeId<Node>(path, index_constant<i>{});
+        else
+        {
+          auto k = path[index_constant<i>{}];
+          assert(id < _firstChild.size() and _firstChild[id] + k < _childIds.size());
+          return lookup<Detail::ChildTypeAt<Node,decltype(k)>>(_childIds[_firstChild[id] + k], path, index_constant<i+1>{});
+        }
+      }
+
+      std::size_t _size = 0;
+      std::vector<std::size_t> _childIds;
+      std::vector<std::size_t> _firstChild;
+    };
+
+    //! A side table storing a value for every node of a tree, inner nodes as well as leafs.
+    /**
+     * \code
+     #include <dune/typetree/nodemap.hh>
+     * \endcode
+     * The values are stored contiguously in the order of the ids given by NodeIds and
+     * accessed by the path of the node in constant time with respect to the size of the
+     * tree. For trees without nodes of dynamic degree, the values are stored in a
+     * std::array and the position of a value is a compile time constant if the path
+     * consists of compile time indices only.
+     *
+     * \code{.cc}
+     * auto sizes = makeNodeMap<std::size_t>(tree);
+     * forEachNode(tree, [&](auto&& node, auto treePath) {
+     *   sizes[treePath] = ...;
+     * });
+     * \endcode
+     *
+     * Nodes are identified by their position within the tree, not by their address,
+     * as the same node object may appear at several positions, e.g. as all children of
+     * a power node.
+     *
+     * \tparam Tree The type of the tree.
+     * \tparam Value The type of the values.
+     */
+    template<class Tree, class Value>
+    class NodeMap
+    {
+      static constexpr auto storage ()
+      {
+        if constexpr (NodeIds<Tree>::isStatic)
+          return std::array<Value,nodeCount<Tree>()>{};
+        else
+          return std::vector<Value>{};
+      }
+
+    public:
+
+      using Storage = decltype(storage());
+
+      //! Create a map for the nodes of tree with all values initialized to value.
+      explicit NodeMap (const Tree& tree, const Value& value = Value{})
+        : _ids(tree)
+      {
+        Detail::assignNodeValues(_values, _ids.size(), value);
+      }
+
+      //! Update the map after the degree of a node has changed, all values are reset to value.
+      void update (const Tree& tree, const Value& value = Value{})
+      {
+        _ids.update(tree);
+        Detail::assignNodeValues(_values, _ids.size(), value);
+      }
+
+      //! The value of the node at the given path.
+      template<class... T>
+      const Value& operator[] (const HybridTreePath<T...>& path) const
+      {
+        return _values[_ids[path]];
+      }
+
+      //! The value of the node at the given path.
+      template<class... T>
+      Value& operator[] (const HybridTreePath<T...>& path)
+      {
+        return _values[_ids[path]];
+      }
+
+      //! The number of nodes.
+      std::size_t size () const
+      {
+        return _ids.size();
+      }
+
+      //! The values of all nodes, ordered by their ids.
+      std::span<const Value> values () const
+      {
+        return _values;
+      }
+
+      //! The values of all nodes, ordered by their ids.
+      std::span<Value> values ()
+      {
+        return _values;
+      }
+
+      //! The ids of the nodes, i.e. the positions of their values within values().
+      const NodeIds<Tree>& ids () const
+      {
+        return _ids;
+      }
+
+    private:
+      NodeIds<Tree> _ids;
+      Storage _values;
+    };
+
+    //! Create a NodeMap storing a value of type Value for every node of tree.
+    /**
+     * \code
+     #include <dune/typetree/nodemap.hh>
+     * \endcode
+     * \tparam Value The type of the values.
+     * \param tree The tree.
+     * \param value The initial value of all nodes.
+     */
+    template<class Value, class Tree>
+    NodeMap<Tree,Value> makeNodeMap (const Tree& tree, const Value& value = Value{})
+    {
+      return NodeMap<Tree,Value>(tree, value);
+    }
+
+    //! \} group TypeTree
+
+  } // namespace TypeTree
+} //namespace Dune
+
+#endif // DUNE_TYPETREE_NODEMAP_HH
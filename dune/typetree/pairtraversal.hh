@@ -6,8 +6,6 @@
 #ifndef DUNE_TYPETREE_PAIRTRAVERSAL_HH
 #define DUNE_TYPETREE_PAIRTRAVERSAL_HH
 
-#include <dune/common/std/type_traits.hh>
-
 #include <dune/typetree/nodeinterface.hh>
 #include <dune/typetree/nodetags.hh>
 #include <dune/typetree/treepath.hh>
@@ -60,28 +58,24 @@ namespace Dune {
         visitor.pre(tree1, tree2, treePath);
 
         // check which type of traversal is supported by the trees
-        using allowDynamicTraversal = std::conjunction<
-          Dune::Std::is_detected<DynamicTraversalConcept,Tree1>,
-          Dune::Std::is_detected<DynamicTraversalConcept,Tree2>>;
-        using allowStaticTraversal = std::conjunction<
-          Dune::Std::is_detected<StaticTraversalConcept,Tree1>,
-          Dune::Std::is_detected<StaticTraversalConcept,Tree2>>;
+        constexpr bool allowDynamicTraversal = DynamicTraversable<Tree1> and DynamicTraversable<Tree2>;
+        constexpr bool allowStaticTraversal = StaticTraversable<Tree1> and StaticTraversable<Tree2>;
 
         // both trees must support either dynamic or static traversal
-        static_assert(allowDynamicTraversal::value || allowStaticTraversal::value);
+        static_assert(allowDynamicTraversal || allowStaticTraversal);
 
         // the visitor may specify preferred dynamic traversal
         using preferDynamicTraversal = std::bool_constant<Visitor::treePathType == TreePathType::dynamic>;
 
         // create a dynamic or static index range
         auto indices = [&]{
-          if constexpr(preferDynamicTraversal::value && allowDynamicTraversal::value)
+          if constexpr(preferDynamicTraversal::value && allowDynamicTraversal)
             return Dune::range(std::size_t(tree1.degree()));
           else
             return Dune::range(tree1.degree());
         }();
 
-        if constexpr(allowDynamicTraversal::value || allowStaticTraversal::value) {
+        if constexpr(allowDynamicTraversal || allowStaticTraversal) {
           Dune::Hybrid::forEach(indices, [&](auto i) {
             auto&& child1 = tree1.child(i);
             auto&& child2 = tree2.child(i);
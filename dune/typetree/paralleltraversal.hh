@@ -0,0 +1,670 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+
+#ifndef DUNE_TYPETREE_PARALLELTRAVERSAL_HH
+#define DUNE_TYPETREE_PARALLELTRAVERSAL_HH
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/hybridutilities.hh>
+#include <dune/common/rangeutilities.hh>
+
+#include <dune/typetree/nodeinterface.hh>
+#include <dune/typetree/shapehash.hh>
+#include <dune/typetree/traversal.hh>
+#include <dune/typetree/treepath.hh>
+#include <dune/typetree/utility.hh>
+#include <dune/typetree/visitor.hh>
+
+namespace Dune {
+  namespace TypeTree {
+
+    /** \addtogroup Tree Traversal
+     *  \ingroup TypeTree
+     *  \{
+     */
+
+    //! A small work-stealing thread pool for the parallel traversal of trees.
+    /**
+     * Every worker thread owns a queue of tasks. New tasks are appended to the queue
+     * of the spawning thread and are taken from the back by the owner (depth first),
+     * while idle workers steal tasks from the front of the other queues (breadth first),
+     * where the largest chunks of work are usually found. Threads that do not belong
+     * to the pool share one additional queue.
+     *
+     * Tasks are spawned and joined by means of a TaskGroup. A thread waiting for the
+     * tasks of a group executes pending tasks in the meantime. It only blocks if it
+     * repeatedly fails to find a pending task, until new tasks are spawned or the
+     * tasks of the group are finished.
+     *
+     * \sa applyToTree(Tree&&,Visitor&&,TraversalThreadPool&,std::size_t)
+     */
+    class TraversalThreadPool
+    {
+
+      using Task = std::function<void()>;
+
+      struct Queue
+      {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+      };
+
+    public:
+
+      //! A set of tasks that is joined by wait().
+      class TaskGroup
+      {
+      public:
+
+        explicit TaskGroup (TraversalThreadPool& pool)
+          : _pool(pool)
+        {}
+
+        TaskGroup (const TaskGroup&) = delete;
+        TaskGroup& operator= (const TaskGroup&) = delete;
+
+        //! Waits for all tasks of the group, discarding any exception they might have thrown.
+        ~TaskGroup ()
+        {
+          join();
+        }
+
+        //! Enqueue the function f for asynchronous execution.
+        template<class F>
+        void run (F&& f)
+        {
+          _active.fetch_add(1);
+          _pool.push([this, &pool = _pool, f = std::forward<F>(f)]() mutable {
+            try {
+              f();
+            } catch (...) {
+              std::lock_guard<std::mutex> lock(_exceptionMutex);
+              if (not _exception)
+                _exception = std::current_exception();
+            }
+            // this must be the last access to the group, it may be destroyed afterwards
+            if (_active.fetch_sub(1) == 1)
+              pool.notifyJoins();
+          });
+        }
+
+        //! Wait for all tasks of the group, executing pending tasks in the meantime.
+        /**
+         * If one of the tasks has thrown an exception, the first one is rethrown.
+         */
+        void wait ()
+        {
+          join();
+          if (_exception)
+            std::rethrow_exception(std::exchange(_exception, nullptr));
+        }
+
+      private:
+
+        void join ()
+        {
+          std::size_t failedSteals = 0;
+          while (_active.load() > 0)
+          {
+            if (_pool.tryRunTask())
+              failedSteals = 0;
+            else if (++failedSteals < maxFailedSteals)
+              std::this_thread::yield();
+            else
+            {
+              _pool.sleep([&]{ return _active.load() == 0; });
+              failedSteals = 0;
+            }
+          }
+        }
+
+        // the number of unsuccessful attempts to run a task before join() blocks
+        static constexpr std::size_t maxFailedSteals = 64;
+
+        TraversalThreadPool& _pool;
+        std::atomic<std::size_t> _active = 0;
+        std::mutex _exceptionMutex;
+        std::exception_ptr _exception;
+      };
+
+      //! Start the given number of worker threads.
+      /**
+       * The threads calling TaskGroup::wait() participate in the execution of tasks,
+       * so a pool without any workers executes all tasks in the waiting thread.
+       */
+      explicit TraversalThreadPool (std::size_t workers = std::thread::hardware_concurrency())
+      {
+        _queues.reserve(workers+1);
+        for (std::size_t i = 0; i < workers+1; ++i)
+          _queues.push_back(std::make_unique<Queue>());
+        _workers.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i)
+          _workers.emplace_back([this,i]{ workerLoop(i+1); });
+      }
+
+      TraversalThreadPool (const TraversalThreadPool&) = delete;
+      TraversalThreadPool& operator= (const TraversalThreadPool&) = delete;
+
+      ~TraversalThreadPool ()
+      {
+        {
+          std::lock_guard<std::mutex> lock(_sleepMutex);
+          _stop = true;
+        }
+        _wakeUp.notify_all();
+        for (auto& worker : _workers)
+          worker.join();
+      }
+
+      //! The number of worker threads.
+      std::size_t workers () const
+      {
+        return _workers.size();
+      }
+
+    private:
+
+      // the queue owned by the calling thread, queue 0 is shared by all foreign threads
+      std::size_t ownQueue () const
+      {
+        return _currentPool == this ? _currentQueue : 0;
+      }
+
+      void push (Task task)
+      {
+        Queue& queue = *_queues[ownQueue()];
+        {
+          std::lock_guard<std::mutex> lock(queue.mutex);
+          queue.tasks.push_back(std::move(task));
+          _pending.fetch_add(1);
+        }
+        {
+          // synchronize with workers going to sleep to avoid a lost wake-up
+          std::lock_guard<std::mutex> lock(_sleepMutex);
+        }
+        _wakeUp.notify_one();
+      }
+
+      // run a single task from the own queue or stolen from another one
+      bool tryRunTask ()
+      {
+        Task task;
+        std::size_t own = ownQueue();
+        for (std::size_t k = 0; k < _queues.size() and not task; ++k)
+        {
+          Queue& queue = *_queues[(own+k) % _queues.size()];
+          std::lock_guard<std::mutex> lock(queue.mutex);
+          if (queue.tasks.empty())
+            continue;
+          if (k == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+          } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+          }
+          _pending.fetch_sub(1);
+        }
+        if (not task)
+          return false;
+        task();
+        return true;
+      }
+
+      // block until a task is pending or done() returns true
+      template<class Done>
+      void sleep (Done&& done)
+      {
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepingJoins.fetch_add(1);
+        _wakeUp.wait(lock, [&]{ return _pending.load() > 0 or done(); });
+        _sleepingJoins.fetch_sub(1);
+      }
+
+      // wake up the threads blocked in sleep() after the last task of a group has finished
+      void notifyJoins ()
+      {
+        if (_sleepingJoins.load() == 0)
+          return;
+        {
+          // synchronize with joining threads going to sleep to avoid a lost wake-up
+          std::lock_guard<std::mutex> lock(_sleepMutex);
+        }
+        _wakeUp.notify_all();
+      }
+
+      void workerLoop (std::size_t queue)
+      {
+        _currentPool = this;
+        _currentQueue = queue;
+        while (true)
+        {
+          if (tryRunTask())
+            continue;
+          std::unique_lock<std::mutex> lock(_sleepMutex);
+          _wakeUp.wait(lock, [&]{ return _stop or _pending.load() > 0; });
+          if (_stop and _pending.load() == 0)
+            return;
+        }
+      }
+
+      static inline thread_local const TraversalThreadPool* _currentPool = nullptr;
+      static inline thread_local std::size_t _currentQueue = 0;
+
+      std::vector<std::unique_ptr<Queue>> _queues;
+      std::vector<std::thread> _workers;
+      std::atomic<std::size_t> _pending = 0;
+      std::atomic<std::size_t> _sleepingJoins = 0;
+      std::mutex _sleepMutex;
+      std::condition_variable _wakeUp;
+      bool _stop = false;
+    };
+
+#ifndef DOXYGEN
+
+    namespace Detail {
+
+      /* The number of leafs of all subtrees of a tree, which decides whether
+       * a subtree is large enough to be visited by a separate task. For
+       * subtrees without nodes of run time degree, the number is known at
+       * compile time. Only the nodes of the other subtrees are stored, they
+       * are identified by their position in the order of forEachNode()
+       * restricted to these nodes: the root has id 0, the first stored child
+       * of a node has the id following the one of the node, and every node is
+       * followed by its subtree. The sizes are collected by a single traversal
+       * of the stored nodes before the parallel traversal starts, so each
+       * decision takes constant time.
+       */
+      class SubtreeSizes
+      {
+      public:
+
+        // Whether the number of leafs of Node is stored, otherwise it is known at compile time
+        template<class Node>
+        static constexpr bool isStored = hasDynamicShape<Node>();
+
+        template<class Tree>
+        explicit SubtreeSizes (const Tree& tree)
+        {
+          if constexpr (isStored<Tree>) {
+            const std::size_t nodes = count(tree);
+            _next.reserve(nodes);
+            _leafsBefore.reserve(nodes);
+            _leafsAfter.reserve(nodes);
+            std::size_t leafs = 0;
+            collect(tree, leafs);
+          }
+        }
+
+        // The id of the first stored child of the node with the given id
+        static std::size_t firstChild (std::size_t id)
+        {
+          return id + 1;
+        }
+
+        // The id following the subtree of the given node, i.e. of its next stored sibling
+        template<class Node>
+        std::size_t next (const Node&, std::size_t id) const
+        {
+          if constexpr (isStored<Node>)
+            return _next[id];
+          else
+            return id;
+        }
+
+        // The number of leafs in the subtree of the given node
+        template<class Node>
+        std::size_t leafs (const Node&, std::size_t id) const
+        {
+          if constexpr (isStored<Node>)
+            return _leafsAfter[id] - _leafsBefore[id];
+          else
+            return TreeInfo<Node>::leafCount;
+        }
+
+        // The number of leafs in the subtrees of the children begin,...,end-1 of a node with
+        // run time degree, whose ids are given by childIds if the children are stored
+        template<class Node>
+        std::size_t leafs (const Node&, const std::size_t* childIds, std::size_t begin, std::size_t end) const
+        {
+          if constexpr (isStored<DynamicChildType<Node>>)
+            return _leafsAfter[childIds[end-1]] - _leafsBefore[childIds[begin]];
+          else
+            return (end - begin) * TreeInfo<DynamicChildType<Node>>::leafCount;
+        }
+
+      private:
+
+        template<class Node>
+        static std::size_t count (const Node& node)
+        {
+          std::size_t nodes = 1;
+          Hybrid::forEach(Dune::range(node.degree()), [&](auto i) {
+            if constexpr (isStored<std::decay_t<decltype(node.child(i))>>)
+              nodes += count(node.child(i));
+          });
+          return nodes;
+        }
+
+        template<class Node>
+        void collect (const Node& node, std::size_t& leafs)
+        {
+          std::size_t id = _next.size();
+          _next.push_back(0);
+          _leafsBefore.push_back(leafs);
+          _leafsAfter.push_back(0);
+          Hybrid::forEach(Dune::range(node.degree()), [&](auto i) {
+            using Child = std::decay_t<decltype(node.child(i))>;
+            if constexpr (isStored<Child>)
+              collect(node.child(i), leafs);
+            else
+              leafs += TreeInfo<Child>::leafCount;
+          });
+          _next[id] = _next.size();
+          _leafsAfter[id] = leafs;
+        }
+
+        std::vector<std::size_t> _next;
+        std::vector<std::size_t> _leafsBefore;
+        std::vector<std::size_t> _leafsAfter;
+      };
+
+      /* Variant of applyToTree that visits the children of inner nodes
+       * concurrently. Children with at least grainSize leafs are visited
+       * by a separate task, smaller subtrees are visited sequentially
+       * by the current thread. The calls of afterChild() and post() for
+       * a node are delayed until the tasks of all its children have been
+       * joined, so they always see completely visited subtrees. The id
+       * of the tree refers to the precomputed sizes of its subtrees.
+       */
+      template<class T, class TreePath, class V>
+      void applyToTreeParallel(T&& tree, TreePath treePath, V&& visitor, TraversalThreadPool& pool, std::size_t grainSize,
+        const SubtreeSizes& sizes, std::size_t id)
+      {
+        using Tree = std::remove_reference_t<T>;
+        using Visitor = std::remove_reference_t<V>;
+        if constexpr(Tree::isLeaf) {
+          visitor.leaf(tree, treePath);
+        } else {
+          visitor.pre(tree, treePath);
+
+          // check which type of traversal is supported by the tree
+          constexpr bool allowDynamicTraversal = DynamicTraversable<Tree>;
+          constexpr bool allowStaticTraversal = StaticTraversable<Tree>;
+
+          // the tree must support either dynamic or static traversal
+          static_assert(allowDynamicTraversal || allowStaticTraversal);
+
+          // the visitor may specify preferred dynamic traversal
+          using preferDynamicTraversal = std::bool_constant<Visitor::treePathType == TreePathType::dynamic>;
+
+          // create a dynamic or static index range
+          auto indices = [&]{
+            if constexpr(preferDynamicTraversal::value && allowDynamicTraversal)
+              return Dune::range(std::size_t(tree.degree()));
+            else
+              return Dune::range(tree.degree());
+          }();
+
+          TraversalThreadPool::TaskGroup group(pool);
+          std::size_t childId = SubtreeSizes::firstChild(id);
+          Hybrid::forEach(indices, [&](auto i) {
+            auto&& child = tree.child(i);
+            using Child = std::decay_t<decltype(child)>;
+
+            visitor.beforeChild(tree, child, treePath, i);
+
+            if (i>0)
+              visitor.in(tree, treePath);
+
+            constexpr bool visitChild = Visitor::template VisitChild<Tree,Child,TreePath>::value;
+            if constexpr(visitChild) {
+              auto childTreePath = Dune::TypeTree::push_back(treePath, i);
+              if (not Child::isLeaf and sizes.leafs(child, childId) >= grainSize)
+                group.run([&visitor, &pool, grainSize, &sizes, childId, childPtr = &child, childTreePath] {
+                  applyToTreeParallel(*childPtr, childTreePath, visitor, pool, grainSize, sizes, childId);
+                });
+              else
+                applyToTree(child, childTreePath, visitor);
+            }
+            childId = sizes.next(child, childId);
+          });
+          group.wait();
+
+          Hybrid::forEach(indices, [&](auto i) {
+            visitor.afterChild(tree, tree.child(i), treePath, i);
+          });
+          visitor.post(tree, treePath);
+        }
+      }
+
+      /* Combine the results r[0],...,r[n-1] of the children of a node by a
+       * balanced binary tree of reductions, which only depends on n.
+       */
+      template<class ResultType, class R>
+      ResultType pairwiseReduce(const std::optional<ResultType>* r, std::size_t n, R& reduction)
+      {
+        if (n == 1)
+          return *r[0];
+        std::size_t mid = n / 2;
+        return reduction(pairwiseReduce(r, mid, reduction), pairwiseReduce(r + mid, n - mid, reduction));
+      }
+
+      /* Variant of reduceOverLeafs that reduces the children of inner nodes
+       * concurrently. The results of the children of a node are combined
+       * by pairwiseReduce() in any case, independent of which subtrees are
+       * reduced by separate tasks, so the result only depends on the tree.
+       * For nodes with dynamic degree, the range of children is bisected
+       * recursively and halves with at least grainSize leafs are reduced
+       * by a separate task. The decisions are based on the precomputed
+       * sizes of the subtrees, where id refers to the node. Subtrees with
+       * fewer than grainSize leafs are reduced without any lookup, which is
+       * indicated by sizes being null.
+       */
+      template<class Node, class TreePath, class F, class R, class ResultType>
+      ResultType reduceOverLeafsParallel(const Node& node, TreePath treePath, F& functor, R& reduction,
+        const ResultType& startValue, TraversalThreadPool& pool, std::size_t grainSize,
+        const SubtreeSizes* sizes, std::size_t id);
+
+      // Reduce the children begin,...,end-1 of node, whose ids are given by childIds if they are stored in sizes
+      template<class Node, class TreePath, class F, class R, class ResultType>
+      ResultType reduceChildRangeParallel(const Node& node, TreePath treePath, std::size_t begin, std::size_t end,
+        F& functor, R& reduction, const ResultType& startValue, TraversalThreadPool& pool, std::size_t grainSize,
+        const SubtreeSizes* sizes, const std::size_t* childIds)
+      {
+        if (end - begin == 1)
+          return reduceOverLeafsParallel(node.child(begin), Dune::TypeTree::push_back(treePath, begin),
+            functor, reduction, startValue, pool, grainSize, sizes, childIds ? childIds[begin] : 0);
+
+        // same split as in pairwiseReduce()
+        std::size_t mid = begin + (end - begin) / 2;
+        std::optional<ResultType> left;
+        if (sizes and sizes->leafs(node, childIds, begin, mid) >= grainSize)
+        {
+          TraversalThreadPool::TaskGroup group(pool);
+          group.run([&] {
+            left = reduceChildRangeParallel(node, treePath, begin, mid, functor, reduction, startValue, pool, grainSize, sizes, childIds);
+          });
+          ResultType right = reduceChildRangeParallel(node, treePath, mid, end, functor, reduction, startValue, pool, grainSize, sizes, childIds);
+          group.wait();
+          return reduction(*left, right);
+        }
+        left = reduceChildRangeParallel(node, treePath, begin, mid, functor, reduction, startValue, pool, grainSize, sizes, childIds);
+        return reduction(*left, reduceChildRangeParallel(node, treePath, mid, end, functor, reduction, startValue, pool, grainSize, sizes, childIds));
+      }
+
+      template<class Node, class TreePath, class F, class R, class ResultType>
+      ResultType reduceOverLeafsParallel(const Node& node, TreePath treePath, F& functor, R& reduction,
+        const ResultType& startValue, TraversalThreadPool& pool, std::size_t grainSize,
+        const SubtreeSizes* sizes, std::size_t id)
+      {
+        // no task is spawned within a subtree with fewer than grainSize leafs
+        if (sizes and sizes->leafs(node, id) < grainSize)
+          sizes = nullptr;
+
+        if constexpr(Node::isLeaf)
+          return functor(node, treePath);
+        else if constexpr(DynamicTraversable<Node>)
+        {
+          std::size_t degree = node.degree();
+          if (degree == 0)
+            return startValue;
+          if (not sizes or not SubtreeSizes::isStored<DynamicChildType<Node>>)
+            return reduceChildRangeParallel(node, treePath, 0, degree,
+              functor, reduction, startValue, pool, grainSize, sizes, nullptr);
+
+          std::vector<std::size_t> childIds(degree);
+          childIds[0] = SubtreeSizes::firstChild(id);
+          for (std::size_t i = 1; i < degree; ++i)
+            childIds[i] = sizes->next(node.child(i-1), childIds[i-1]);
+          return reduceChildRangeParallel(node, treePath, 0, degree,
+            functor, reduction, startValue, pool, grainSize, sizes, childIds.data());
+        }
+        else
+        {
+          constexpr std::size_t degree = StaticDegree<Node>::value;
+          if constexpr(degree == 0)
+            return startValue;
+          else
+          {
+            std::array<std::optional<ResultType>,degree> results;
+            {
+              TraversalThreadPool::TaskGroup group(pool);
+              std::size_t childId = SubtreeSizes::firstChild(id);
+              Hybrid::forEach(Dune::range(node.degree()), [&](auto i) {
+                auto&& child = node.child(i);
+                using Child = std::decay_t<decltype(child)>;
+                auto childTreePath = Dune::TypeTree::push_back(treePath, i);
+                if (sizes and not Child::isLeaf and sizes->leafs(child, childId) >= grainSize)
+                  group.run([&, childPtr = &child, childTreePath, childId, result = &results[i]] {
+                    *result = reduceOverLeafsParallel(*childPtr, childTreePath, functor, reduction, startValue, pool, grainSize, sizes, childId);
+                  });
+                else
+                  results[i] = reduceOverLeafsParallel(child, childTreePath, functor, reduction, startValue, pool, grainSize, sizes, childId);
+                if (sizes)
+                  childId = sizes->next(child, childId);
+              });
+              group.wait();
+            }
+            return pairwiseReduce(results.data(), degree, reduction);
+          }
+        }
+      }
+
+    } // namespace Detail
+
+#endif // DOXYGEN
+
+    //! Apply visitor to TypeTree, visiting independent subtrees in parallel.
+    /**
+     * \code
+     #include <dune/typetree/paralleltraversal.hh>
+     * \endcode
+     * This function applies the given visitor to the given tree like
+     * applyToTree(Tree&&,Visitor&&), but every child subtree with at least
+     * `grainSize` leafs is visited by a separate task executed by the given thread
+     * pool. Idle threads steal pending tasks, which balances the load even if the
+     * cost of visiting the subtrees differs a lot. Smaller subtrees are visited
+     * sequentially by the thread that visits their parent. The numbers of leafs of the
+     * subtrees are known at compile time, except for subtrees containing nodes of run time
+     * degree, which are determined once by a sequential traversal before the visit starts.
+     *
+     * The methods of the visitor are called as follows:
+     * - `pre()`, `beforeChild()` and `in()` are called for a node in the same order as
+     *   in a sequential traversal, before the visits of the respective children are started.
+     * - `afterChild()` and `post()` are called for a node after the visits of all of its
+     *   children have been completed (the join point), again in sequential order.
+     * - All methods concerning a single node are called by the same thread.
+     * - The visits of different child subtrees run concurrently. Thus, the visitor is
+     *   shared between threads and its methods must be safe to be called concurrently.
+     *
+     * \note The in-place tree path traversal (InPlaceTraversal) is not supported, as
+     *       it relies on a single tree path shared by all nodes.
+     *
+     * \note Stopping the traversal early by returning TraversalStatus::stop is not
+     *       supported. It ends at most the sequential visit of the current subtree,
+     *       while the concurrent tasks continue.
+     *
+     * \param tree      The tree the visitor will be applied to.
+     * \param visitor   The visitor to apply to the tree.
+     * \param pool      The thread pool executing the tasks.
+     * \param grainSize The minimum number of leafs of a subtree to be visited by a separate task.
+     */
+    template<typename Tree, typename Visitor>
+    void applyToTree(Tree&& tree, Visitor&& visitor, TraversalThreadPool& pool, std::size_t grainSize = 1)
+    {
+      static_assert(std::decay_t<Visitor>::treePathType != TreePathType::inPlace,
+        "The parallel tree traversal does not support the in-place tree path traversal");
+      Detail::SubtreeSizes sizes(tree);
+      Detail::applyToTreeParallel(tree, hybridTreePath(), visitor, pool, grainSize, sizes, 0);
+    }
+
+    //! Calculate a quantity as a reduction over the leaf nodes of a TypeTree in parallel.
+    /**
+     * \code
+     #include <dune/typetree/paralleltraversal.hh>
+     * \endcode
+     * Computes the same quantity as the sequential
+     * reduceOverLeafs(const Tree&,F,R,ResultType), but the functor is applied to
+     * the leafs concurrently by the tasks of the given thread pool. Instead of folding
+     * the results of the leafs from left to right, the results of the children of every
+     * node are combined pairwise by a balanced binary tree of reductions, and the result
+     * of the tree is finally combined with `startValue`.
+     *
+     * The order of all reductions only depends on the shape of the tree, neither on the
+     * number of threads, nor on the grain size, nor on the scheduling of the tasks. Thus,
+     * the result is bitwise reproducible, even for non-associative operations like the
+     * summation of floating point numbers. It agrees with the result of the sequential
+     * reduceOverLeafs() up to the reordering of the reductions, i.e. exactly if the
+     * reduction is associative and `startValue` is its neutral element.
+     *
+     * Children with at least `grainSize` leafs are reduced by separate tasks. The children
+     * of nodes with dynamic degree, e.g. large DynamicPowerNode, are split recursively into
+     * halves, such that a node with many small children is reduced in parallel as well.
+     * The numbers of leafs of subtrees containing nodes of run time degree are determined
+     * once by a sequential traversal before the reduction starts.
+     *
+     * \note The functor and the reduction are called concurrently and must be safe to be
+     *       called from several threads.
+     *
+     * \param tree       The tree on which to perform the calculation.
+     * \param functor    The functor to apply to the leaf nodes.
+     * \param reduction  The operation used to combine the individual results.
+     * \param startValue The initial value for the result, also the result of nodes without children.
+     * \param pool       The thread pool executing the tasks.
+     * \param grainSize  The minimum number of leafs of a subtree to be reduced by a separate task.
+     *
+     * \returns The value obtained by combining the individual results for all leafs.
+     */
+    template<typename ResultType, typename Tree, typename F, typename R>
+    ResultType reduceOverLeafs(const Tree& tree, F functor, R reduction, ResultType startValue,
+      TraversalThreadPool& pool, std::size_t grainSize = 1)
+    {
+      Detail::SubtreeSizes sizes(tree);
+      return reduction(startValue,
+        Detail::reduceOverLeafsParallel(tree, hybridTreePath(), functor, reduction, startValue, pool, grainSize, &sizes, 0));
+    }
+
+    //! \} group Tree Traversal
+
+  } // namespace TypeTree
+} //namespace Dune
+
+#endif // DUNE_TYPETREE_PARALLELTRAVERSAL_HH
@@ -6,12 +6,13 @@
 #ifndef DUNE_TYPETREE_PROXYNODE_HH
 #define DUNE_TYPETREE_PROXYNODE_HH
 
+#include <memory>
 #include <type_traits>
+#include <utility>
 #include <dune/typetree/nodeinterface.hh>
 #include <dune/typetree/nodetags.hh>
 #include <dune/common/shared_ptr.hh>
 #include <dune/common/indices.hh>
-#include <dune/common/std/type_traits.hh>
 
 namespace Dune {
   namespace TypeTree {
@@ -248,6 +249,11 @@ namespace Dune {
      * that need to provide the TypeTree node functionality of the
      * proxied class. It exactly mirrors the TypeTree node characteristics
      * of the proxied node.
+     *
+     * A ProxyNode constructed from a reference to the proxied node does not take
+     * ownership and does not use a `shared_ptr` internally: constructing, copying
+     * and accessing the proxied node never touches a reference count. Only a
+     * ProxyNode constructed from a `shared_ptr` keeps the proxied node alive.
      */
     template<typename Node>
     class ProxyNode
@@ -256,10 +262,7 @@ namespace Dune {
       static const bool proxiedNodeIsConst = std::is_const<typename std::remove_reference<Node>::type>::value;
 
       template <class N>
-      using HasStaticDegree = index_constant<N::degree()>;
-
-      template <class N>
-      static constexpr bool hasStaticDegree = Std::is_detected<HasStaticDegree, N>::value;
+      static constexpr bool hasStaticDegree = requires { index_constant<N::degree()>{}; };
 
       // accessor mixins need to be friends for access to proxiedNode()
       friend class StaticChildAccessors<Node>;
@@ -315,17 +318,25 @@ namespace Dune {
       }
 
       //! Returns the storage of the proxied node.
+      /**
+       * If the proxy does not own the proxied node, this returns a non-owning `shared_ptr`.
+       */
       template<bool enabled = !proxiedNodeIsConst>
       typename std::enable_if<enabled,std::shared_ptr<Node> >::type
       proxiedNodeStorage ()
       {
-        return _node;
+        return _storage ? _storage : stackobject_to_shared_ptr(*_node);
       }
 
       //! Returns the storage of the proxied node (const version).
+      /**
+       * If the proxy does not own the proxied node, this returns a non-owning `shared_ptr`.
+       */
       std::shared_ptr<const Node> proxiedNodeStorage () const
       {
-        return _node;
+        if (_storage)
+          return _storage;
+        return stackobject_to_shared_ptr(std::as_const(*_node));
       }
 
       //! @}
@@ -333,19 +344,23 @@ namespace Dune {
       //! @name Constructors
       //! @{
 
+      //! Refer to the given node without taking ownership.
       ProxyNode (Node& node)
-        : _node(stackobject_to_shared_ptr(node))
+        : _node(&node)
       {}
 
+      //! Share ownership of the given node.
       ProxyNode (std::shared_ptr<Node> node)
-        : _node(std::move(node))
+        : _node(node.get())
+        , _storage(std::move(node))
       {}
 
       //! @}
 
     private:
 
-      std::shared_ptr<Node> _node;
+      Node* _node;
+      std::shared_ptr<Node> _storage;
     };
 
     //! \} group Nodes
@@ -0,0 +1,279 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+
+#ifndef DUNE_TYPETREE_SERIALIZATION_HH
+#define DUNE_TYPETREE_SERIALIZATION_HH
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/typetree/exceptions.hh>
+#include <dune/typetree/nodeinterface.hh>
+#include <dune/typetree/nodetags.hh>
+#include <dune/typetree/shapehash.hh>
+#include <dune/typetree/traversal.hh>
+
+namespace Dune {
+  namespace TypeTree {
+
+    /** \addtogroup TypeTree
+     *  \{
+     */
+
+#ifndef DOXYGEN
+
+    namespace Detail {
+
+      // File signature, the last character is the version of the format
+      inline constexpr std::array<char,8> serializationMagic = {'D','U','N','E','T','T','C','\1'};
+
+      // Written in native byte order to detect files from machines with a different one
+      inline constexpr std::uint64_t serializationByteOrder = 0x0102030405060708;
+
+      // Flag marking the descriptor of a value stored as a range of elements
+      inline constexpr std::uint64_t serializedRangeFlag = std::uint64_t(1) << 63;
+
+      template<class V>
+      concept SerializableRange = std::ranges::contiguous_range<V>
+        and std::ranges::sized_range<V>
+        and std::is_trivially_copyable_v<std::ranges::range_value_t<V>>;
+
+      // The size of a trivially copyable value or the flagged element size of a range
+      template<class V>
+      constexpr std::uint64_t serializedValueDescriptor()
+      {
+        if constexpr (std::is_trivially_copyable_v<V>)
+          return sizeof(V);
+        else {
+          static_assert(SerializableRange<V>,
+            "Only trivially copyable values and contiguous ranges of them can be serialized");
+          return serializedRangeFlag | sizeof(std::ranges::range_value_t<V>);
+        }
+      }
+
+      /* The header following the signature: the byte order mark, the node tag
+       * and the degree of every node in the order of forEachNode(), and the
+       * descriptors of the values of all leafs in the order of forEachLeafNode().
+       * Each block is preceded by its length.
+       */
+      template<class Tree, class Container>
+      std::vector<std::uint64_t> serializationHeader(const Tree& tree, const Container& container)
+      {
+        std::vector<std::uint64_t> nodes;
+        std::vector<std::uint64_t> values;
+        forEachNode(tree, [&](auto&& node, auto treePath) {
+          nodes.push_back(nodeTagCode<NodeTag<decltype(node)>>());
+          nodes.push_back(node.degree());
+          if constexpr (std::decay_t<decltype(node)>::isLeaf)
+            values.push_back(serializedValueDescriptor<std::decay_t<decltype(container[treePath])>>());
+        });
+
+        std::vector<std::uint64_t> header = {serializationByteOrder, nodes.size()};
+        header.insert(header.end(), nodes.begin(), nodes.end());
+        header.push_back(values.size());
+        header.insert(header.end(), values.begin(), values.end());
+        return header;
+      }
+
+      template<class Container>
+      concept FlatTriviallyCopyableStorage = requires (Container& container) {
+        container.values().data();
+      } and std::is_trivially_copyable_v<std::remove_cvref_t<decltype(*std::declval<Container&>().values().data())>>;
+
+      template<class T>
+      void writeBytes(std::ostream& out, const T* data, std::size_t count)
+      {
+        out.write(reinterpret_cast<const char*>(data), count * sizeof(T));
+      }
+
+      template<class T>
+      void readBytes(std::istream& in, T* data, std::size_t count)
+      {
+        in.read(reinterpret_cast<char*>(data), count * sizeof(T));
+      }
+
+      template<class V>
+      void writeValue(std::ostream& out, const V& value)
+      {
+        if constexpr (std::is_trivially_copyable_v<V>)
+          writeBytes(out, &value, 1);
+        else {
+          std::uint64_t size = std::ranges::size(value);
+          writeBytes(out, &size, 1);
+          writeBytes(out, std::ranges::data(value), size);
+        }
+      }
+
+      // The number of bytes left in the stream, or the largest possible value if the stream is not seekable
+      inline std::uint64_t remainingBytes(std::istream& in)
+      {
+        const auto pos = in.tellg();
+        if (pos == std::istream::pos_type(-1))
+          return std::numeric_limits<std::uint64_t>::max();
+        in.seekg(0, std::ios_base::end);
+        const auto end = in.tellg();
+        in.seekg(pos);
+        if (not in or end == std::istream::pos_type(-1) or end < pos)
+        {
+          in.clear();
+          in.seekg(pos);
+          return std::numeric_limits<std::uint64_t>::max();
+        }
+        return std::uint64_t(end - pos);
+      }
+
+      /* Read a value written by writeValue(). The length of a range is checked
+       * against the number of bytes left in the stream, which is decreased by
+       * the bytes read, before any memory is allocated for it.
+       */
+      template<class V>
+      void readValue(std::istream& in, V& value, std::uint64_t& remaining)
+      {
+        if constexpr (std::is_trivially_copyable_v<V>)
+          readBytes(in, &value, 1);
+        else {
+          using Element = std::ranges::range_value_t<V>;
+          std::uint64_t size = 0;
+          readBytes(in, &size, 1);
+          if (not in)
+            return;
+          remaining -= std::min<std::uint64_t>(remaining, sizeof(size));
+          if (size > remaining / sizeof(Element))
+            DUNE_THROW(Dune::TypeTree::Exception, "Stored range of size " << size << " exceeds the remaining " << remaining << " bytes of the stream");
+          remaining -= size * sizeof(Element);
+          if constexpr (requires { value.resize(size); })
+            value.resize(size);
+          else if (size != std::ranges::size(value))
+            DUNE_THROW(Dune::TypeTree::Exception, "Stored range of size " << size << " does not fit into value of size " << std::ranges::size(value));
+          readBytes(in, std::ranges::data(value), size);
+        }
+      }
+
+    } // namespace Detail
+
+#endif // DOXYGEN
+
+    //! Write the values of a tree container in a binary format.
+    /**
+     * \code
+     #include <dune/typetree/serialization.hh>
+     * \endcode
+     * The written data consists of a header describing the shape of the tree, i.e. the
+     * node tag and the degree of every node, and the sizes of the leaf values, followed
+     * by the values of all leafs in the order of forEachLeafNode(). The values are written
+     * as raw bytes in native byte order, without any formatting.
+     *
+     * The values must either be trivially copyable or contiguous ranges of trivially
+     * copyable elements, like `std::vector<double>`, which are stored with their length.
+     * The values of a container created by makeFlatTreeContainer() with trivially copyable
+     * value type are written by a single bulk write.
+     *
+     * \param out       The binary output stream.
+     * \param tree      The tree the container was created for.
+     * \param container The container created by makeTreeContainer() or makeFlatTreeContainer().
+     *
+     * \throws Dune::IOError if writing to the stream fails.
+     */
+    template<class Tree, class Container>
+    void writeTreeContainer(std::ostream& out, const Tree& tree, const Container& container)
+    {
+      auto header = Detail::serializationHeader(tree, container);
+      Detail::writeBytes(out, Detail::serializationMagic.data(), Detail::serializationMagic.size());
+      Detail::writeBytes(out, header.data(), header.size());
+
+      if constexpr (Detail::FlatTriviallyCopyableStorage<const Container>)
+        Detail::writeBytes(out, container.values().data(), container.values().size());
+      else
+        forEachLeafNode(tree, [&](auto&&, auto treePath) {
+          Detail::writeValue(out, container[treePath]);
+        });
+
+      if (not out)
+        DUNE_THROW(Dune::IOError, "Writing tree container failed");
+    }
+
+    //! Read the values of a tree container written by writeTreeContainer().
+    /**
+     * \code
+     #include <dune/typetree/serialization.hh>
+     * \endcode
+     * The header is read first and validated against the shape of the given tree and the
+     * value sizes of the given container, before any value is read. Then the values are
+     * read from the stream directly into the container, leaf by leaf or, for a container
+     * created by makeFlatTreeContainer(), by a single bulk read. The container must match
+     * the tree, e.g. it was created for the tree or resized to it.
+     *
+     * \param in        The binary input stream.
+     * \param tree      The tree the container was created for.
+     * \param container The container to store the values in.
+     *
+     * The lengths of stored ranges are checked against the size of the stream before memory
+     * is allocated for them, such that a corrupt file cannot cause an excessive allocation.
+     * This check requires a seekable stream, e.g. a `std::ifstream`.
+     *
+     * \throws Dune::TypeTree::Exception if the stored data does not match the tree or the container,
+     *         or if the length of a stored range exceeds the size of the stream.
+     * \throws Dune::IOError if reading from the stream fails.
+     */
+    template<class Tree, class Container>
+    void readTreeContainer(std::istream& in, const Tree& tree, Container& container)
+    {
+      std::array<char,Detail::serializationMagic.size()> magic;
+      Detail::readBytes(in, magic.data(), magic.size());
+      if (not in)
+        DUNE_THROW(Dune::IOError, "Reading tree container header failed");
+      if (magic != Detail::serializationMagic)
+        DUNE_THROW(Dune::TypeTree::Exception, "Stream does not contain a tree container of a supported format version");
+
+      auto header = Detail::serializationHeader(tree, std::as_const(container));
+      const std::size_t valuesBegin = 2 + header[1];
+      for (std::size_t i = 0; i < header.size(); ++i)
+      {
+        std::uint64_t entry = 0;
+        Detail::readBytes(in, &entry, 1);
+        if (not in)
+          DUNE_THROW(Dune::IOError, "Reading tree container header failed");
+        if (entry == header[i])
+          continue;
+        if (i == 0)
+          DUNE_THROW(Dune::TypeTree::Exception, "Tree container was written with different byte order");
+        else if (i < valuesBegin)
+          DUNE_THROW(Dune::TypeTree::Exception, "Stored tree container does not match the shape of the tree");
+        else
+          DUNE_THROW(Dune::TypeTree::Exception, "Stored tree container does not match the value sizes of the container");
+      }
+
+      if constexpr (Detail::FlatTriviallyCopyableStorage<Container>)
+        Detail::readBytes(in, container.values().data(), container.values().size());
+      else
+      {
+        std::uint64_t remaining = Detail::remainingBytes(in);
+        forEachLeafNode(tree, [&](auto&&, auto treePath) {
+          Detail::readValue(in, container[treePath], remaining);
+        });
+      }
+
+      if (not in)
+        DUNE_THROW(Dune::IOError, "Reading tree container values failed");
+    }
+
+    //! \} group TypeTree
+
+  } // namespace TypeTree
+} //namespace Dune
+
+#endif // DUNE_TYPETREE_SERIALIZATION_HH
@@ -0,0 +1,183 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+
+#ifndef DUNE_TYPETREE_SHAPEHASH_HH
+#define DUNE_TYPETREE_SHAPEHASH_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include <dune/common/hybridutilities.hh>
+#include <dune/common/indices.hh>
+#include <dune/common/rangeutilities.hh>
+
+#include <dune/typetree/nodeinterface.hh>
+#include <dune/typetree/nodetags.hh>
+#include <dune/typetree/traversal.hh>
+
+namespace Dune {
+  namespace TypeTree {
+
+    /** \addtogroup TypeTree
+     *  \{
+     */
+
+#ifndef DOXYGEN
+
+    namespace Detail {
+
+      // Stable numbering of the node tags, used for hashing and serialization
+      template<class Tag>
+      constexpr std::uint64_t nodeTagCode()
+      {
+        if constexpr (std::is_same_v<Tag,LeafNodeTag>)
+          return 0;
+        else if constexpr (std::is_same_v<Tag,PowerNodeTag>)
+          return 1;
+        else if constexpr (std::is_same_v<Tag,DynamicPowerNodeTag>)
+          return 2;
+        else if constexpr (std::is_same_v<Tag,CompositeNodeTag>)
+          return 3;
+        else
+          return 255;
+      }
+
+      // FNV-1a offset basis
+      inline constexpr std::uint64_t shapeHashSeed = 0xcbf29ce484222325;
+
+      // Folded in instead of the degree of a node whose degree is only known at run time
+      inline constexpr std::uint64_t unknownDegree = ~std::uint64_t(0);
+
+      // FNV-1a over the bytes of value, in an order independent of the platform
+      constexpr std::uint64_t shapeHashCombine(std::uint64_t hash, std::uint64_t value)
+      {
+        for (std::size_t i = 0; i < sizeof(value); ++i)
+        {
+          hash ^= (value >> (8*i)) & 0xff;
+          hash *= 0x100000001b3;
+        }
+        return hash;
+      }
+
+      template<class Node, std::size_t k>
+      using StaticChildType = std::decay_t<decltype(std::declval<const Node&>().child(index_constant<k>{}))>;
+
+      template<class Node>
+      using DynamicChildType = std::decay_t<decltype(std::declval<const Node&>().child(std::size_t(0)))>;
+
+      // Whether the subtree rooted in Node contains a node with dynamic degree
+      template<class Node>
+      constexpr bool hasDynamicShape()
+      {
+        if constexpr (Node::isLeaf)
+          return false;
+        else if constexpr (not StaticTraversable<Node>)
+          return true;
+        else if constexpr (Node::isPower)
+          // exploit the fact that all children are identical
+          return hasDynamicShape<typename Node::ChildType>();
+        else
+          return unpackIntegerSequence([](auto... k) {
+            return (hasDynamicShape<StaticChildType<Node,k>>() or ...);
+          }, std::make_index_sequence<StaticDegree<Node>::value>{});
+      }
+
+      template<class Node>
+      constexpr std::uint64_t staticShapeHash()
+      {
+        std::uint64_t hash = shapeHashCombine(shapeHashSeed, nodeTagCode<NodeTag<Node>>());
+        if constexpr (Node::isLeaf)
+          return hash;
+        else if constexpr (not StaticTraversable<Node>)
+        {
+          hash = shapeHashCombine(hash, unknownDegree);
+          return shapeHashCombine(hash, staticShapeHash<DynamicChildType<Node>>());
+        }
+        else if constexpr (Node::isPower)
+        {
+          // exploit the fact that all children are identical
+          hash = shapeHashCombine(hash, StaticDegree<Node>::value);
+          return shapeHashCombine(hash, staticShapeHash<typename Node::ChildType>());
+        }
+        else
+        {
+          hash = shapeHashCombine(hash, StaticDegree<Node>::value);
+          return unpackIntegerSequence([&](auto... k) {
+            ((hash = shapeHashCombine(hash, staticShapeHash<StaticChildType<Node,k>>())), ...);
+            return hash;
+          }, std::make_index_sequence<StaticDegree<Node>::value>{});
+        }
+      }
+
+      template<class Node>
+      std::uint64_t dynamicShapeHash(const Node& node)
+      {
+        // subtrees without nodes of dynamic degree are hashed at compile time
+        if constexpr (not hasDynamicShape<Node>())
+          return staticShapeHash<Node>();
+        else
+        {
+          std::uint64_t hash = shapeHashCombine(shapeHashSeed, nodeTagCode<NodeTag<Node>>());
+          hash = shapeHashCombine(hash, std::size_t(node.degree()));
+          Dune::Hybrid::forEach(Dune::range(node.degree()), [&](auto i) {
+            hash = shapeHashCombine(hash, dynamicShapeHash(node.child(i)));
+          });
+          return hash;
+        }
+      }
+
+    } // namespace Detail
+
+#endif // DOXYGEN
+
+    //! Returns a hash of the shape of the tree type, computed at compile time.
+    /**
+     * \code
+     #include <dune/typetree/shapehash.hh>
+     * \endcode
+     * The shape of a tree consists of the node tag and the degree of every node
+     * and the shapes of its children. Trees of the same shape have the same hash,
+     * independent of the actual node types, e.g. the leaf types or the types stored
+     * in the nodes. The hash does not depend on the compiler or the platform, so it
+     * can be stored and compared later, e.g. to key caches or to validate checkpoints.
+     *
+     * The degree of a node with dynamic degree, like DynamicPowerNode, is not known
+     * at compile time. For such a node, only the shape of the child type enters the
+     * hash. Use treeShapeHash(const Tree&) to include the actual degrees.
+     *
+     * \tparam Tree The type of the tree.
+     */
+    template<class Tree>
+    constexpr std::uint64_t treeShapeHash()
+    {
+      return Detail::staticShapeHash<std::decay_t<Tree>>();
+    }
+
+    //! Returns a hash of the shape of the tree, including the degrees of nodes with dynamic degree.
+    /**
+     * \code
+     #include <dune/typetree/shapehash.hh>
+     * \endcode
+     * In contrast to treeShapeHash<Tree>(), the current degree of every node with
+     * dynamic degree and the shapes of all its children enter the hash. Only the
+     * subtrees containing such nodes are traversed; if there are none, the result
+     * is treeShapeHash<Tree>() and no traversal takes place.
+     *
+     * \param tree The tree.
+     */
+    template<class Tree>
+    std::uint64_t treeShapeHash(const Tree& tree)
+    {
+      return Detail::dynamicShapeHash(tree);
+    }
+
+    //! \} group TypeTree
+
+  } // namespace TypeTree
+} //namespace Dune
+
+#endif // DUNE_TYPETREE_SHAPEHASH_HH
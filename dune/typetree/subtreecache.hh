@@ -0,0 +1,215 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+
+#ifndef DUNE_TYPETREE_SUBTREECACHE_HH
+#define DUNE_TYPETREE_SUBTREECACHE_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dune/common/hybridutilities.hh>
+#include <dune/common/rangeutilities.hh>
+#include <dune/common/typetraits.hh>
+
+#include <dune/typetree/childextraction.hh>
+#include <dune/typetree/nodemap.hh>
+#include <dune/typetree/traversal.hh>
+#include <dune/typetree/treepath.hh>
+
+namespace Dune {
+  namespace TypeTree {
+
+    /** \addtogroup Tree Traversal
+     *  \ingroup TypeTree
+     *  \{
+     */
+
+    //! Caches the results of a reduction over the leafs of every subtree of a tree.
+    /**
+     * \code
+     #include <dune/typetree/subtreecache.hh>
+     * \endcode
+     * Computes the same quantity as reduceOverLeafs(), but for every node of the
+     * tree, and stores the results in a NodeMap. The result of a node is the reduction
+     * of the results of its children, starting with `startValue`, and the result of a
+     * leaf is `functor(leaf,treePath)`. Thus, `reduction` must be associative and
+     * `startValue` must be its neutral element for the results to agree with
+     * reduceOverLeafs().
+     *
+     * Results are computed on demand and stay valid until the tree changes. The cache
+     * has to be told about changes: invalidate() marks a subtree and all its ancestors
+     * as changed, e.g. after the data of a leaf has been modified, and setChild()
+     * replaces a child of the tree and invalidates it in one step. The next call to
+     * result() only recomputes the marked nodes, reusing the cached results of all
+     * unchanged siblings. A query for an unchanged subtree is a single lookup.
+     *
+     * \code{.cc}
+     * auto sizes = makeSubtreeCache<std::size_t>(tree,
+     *   [](auto&& leaf, auto treePath) { return leaf.finiteElement().size(); },
+     *   std::plus<>(), std::size_t(0));
+     * std::size_t total = sizes.result(tree);
+     * std::size_t velocity = sizes.result(tree, treePath(_0));
+     * \endcode
+     *
+     * \tparam Tree       The type of the tree.
+     * \tparam ResultType The result type of the functor and the reduction.
+     * \tparam F          The functor applied to the leafs, see reduceOverLeafs().
+     * \tparam R          The reduction used to combine the results.
+     */
+    template<typename Tree, typename ResultType, typename F, typename R>
+    class SubtreeCache
+    {
+    public:
+
+      //! Create an empty cache for tree, no results are computed yet.
+      SubtreeCache (const Tree& tree, F functor, R reduction, ResultType startValue)
+        : _functor(functor)
+        , _reduction(reduction)
+        , _startValue(startValue)
+        , _results(tree)
+      {}
+
+      //! The reduction over all leafs of tree.
+      ResultType result (const Tree& tree)
+      {
+        return compute(tree, HybridTreePath<>{});
+      }
+
+      //! The reduction over all leafs of the subtree at the given path.
+      template<class... T>
+      ResultType result (const Tree& tree, const HybridTreePath<T...>& path)
+      {
+        return compute(child(tree, path), path);
+      }
+
+      //! Mark the subtree at the given path and all its ancestors as changed.
+      /**
+       * The shape of the subtree must not have changed, use setChild() or update()
+       * for that.
+       */
+      template<class... T>
+      void invalidate (const Tree& tree, const HybridTreePath<T...>& path)
+      {
+        using Node = std::decay_t<decltype(child(tree, path))>;
+        std::size_t first = _results.ids()[path];
+        std::size_t count = NodeIds<Node>(child(tree, path)).size();
+        auto values = _results.values();
+        std::fill(values.begin() + first, values.begin() + first + count, std::nullopt);
+        invalidateAncestors(path);
+      }
+
+      //! Replace the child at the given path by newChild and invalidate it.
+      /**
+       * newChild is passed to the `setChild()` method of the parent node, i.e. it may be a
+       * reference or a `shared_ptr`. If the shape of the replaced subtree is known at compile
+       * time, only the subtree and its ancestors are invalidated. Otherwise, the node ids are
+       * computed again and the cached results of all unchanged subtrees are kept.
+       */
+      template<class... T, class Child>
+      void setChild (Tree& tree, const HybridTreePath<T...>& path, Child&& newChild)
+      {
+        static_assert(sizeof...(T) > 0, "The root of the tree cannot be replaced");
+        using Node = std::decay_t<decltype(child(tree, path))>;
+        if constexpr (NodeIds<Node>::isStatic)
+        {
+          setChildOfParent(child(tree, pop_back(path)), back(path), std::forward<Child>(newChild));
+          invalidate(tree, path);
+        }
+        else
+        {
+          // the subtree occupies a contiguous range of ids, which is resized
+          std::size_t first = _results.ids()[path];
+          std::size_t oldCount = NodeIds<Node>(child(tree, path)).size();
+          setChildOfParent(child(tree, pop_back(path)), back(path), std::forward<Child>(newChild));
+          std::size_t newCount = NodeIds<Node>(child(tree, path)).size();
+
+          std::vector<std::optional<ResultType>> old(_results.values().begin(), _results.values().end());
+          _results.update(tree);
+          auto values = _results.values();
+          std::copy(old.begin(), old.begin() + first, values.begin());
+          std::copy(old.begin() + first + oldCount, old.end(), values.begin() + first + newCount);
+          invalidateAncestors(path);
+        }
+      }
+
+      //! Discard all results, e.g. after several changes of the shape of the tree.
+      void update (const Tree& tree)
+      {
+        _results.update(tree);
+      }
+
+    private:
+
+      template<class Node, class Path>
+      ResultType compute (const Node& node, const Path& path)
+      {
+        if (const auto& cached = _results[path])
+          return *cached;
+
+        ResultType value = _startValue;
+        if constexpr (Node::isLeaf)
+          value = _functor(node, path);
+        else if constexpr (Detail::DynamicTraversable<Node>)
+        {
+          for (std::size_t i = 0; i < std::size_t(node.degree()); ++i)
+            value = _reduction(value, compute(node.child(i), push_back(path, i)));
+        }
+        else
+          Dune::Hybrid::forEach(Dune::range(node.degree()), [&](auto i) {
+            value = _reduction(value, compute(node.child(i), push_back(path, i)));
+          });
+        _results[path] = value;
+        return value;
+      }
+
+      template<class... T>
+      void invalidateAncestors (const HybridTreePath<T...>& path)
+      {
+        _results[path].reset();
+        if constexpr (sizeof...(T) > 0)
+          invalidateAncestors(pop_back(path));
+      }
+
+      template<class Parent, class Index, class Child>
+      static void setChildOfParent (Parent& parent, Index i, Child&& newChild)
+      {
+        if constexpr (IsIntegralConstant<Index>::value and Detail::StaticTraversable<Parent>)
+          parent.setChild(std::forward<Child>(newChild), i);
+        else
+          parent.setChild(std::size_t(i), std::forward<Child>(newChild));
+      }
+
+      F _functor;
+      R _reduction;
+      ResultType _startValue;
+      NodeMap<Tree,std::optional<ResultType>> _results;
+    };
+
+    //! Create a SubtreeCache for a reduction over the leafs of tree, see reduceOverLeafs().
+    /**
+     * \code
+     #include <dune/typetree/subtreecache.hh>
+     * \endcode
+     * \param tree       The tree on which to perform the calculation.
+     * \param functor    The functor to apply to the leaf nodes.
+     * \param reduction  The associative operation used to combine the individual results.
+     * \param startValue The neutral element of the reduction.
+     */
+    template<typename ResultType, typename Tree, typename F, typename R>
+    SubtreeCache<Tree,ResultType,F,R> makeSubtreeCache (const Tree& tree, F functor, R reduction, ResultType startValue)
+    {
+      return SubtreeCache<Tree,ResultType,F,R>(tree, functor, reduction, startValue);
+    }
+
+    //! \} group Tree Traversal
+
+  } // namespace TypeTree
+} //namespace Dune
+
+#endif // DUNE_TYPETREE_SUBTREECACHE_HH
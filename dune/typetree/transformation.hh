@@ -86,6 +86,10 @@ namespace Dune {
      * This struct can be used to apply a transformation to a given TypeTree. It exports the type of
      * the resulting (transformed) tree and contains methods to actually transform tree instances.
      *
+     * The transformation of a tree can be compiled once in a dedicated translation unit by
+     * explicitly instantiating the member functions of this struct, see the CMake function
+     * `dune_typetree_add_instantiations()`.
+     *
      * \tparam SourceTree     = The TypeTree that should be transformed.
      * \tparam Transformation = The Transformation to apply to the TypeTree.
      * \tparam Tag            = This parameter is an implementation detail and must always be set to its default value.
@@ -113,47 +117,78 @@ namespace Dune {
       typedef type Type;
 
       //! Apply transformation to an existing tree s.
-      static transformed_type transform(const SourceTree& s, const Transformation& t = Transformation())
-      {
-        return TransformTree<SourceTree,Transformation,NodeTag<SourceTree>,NodeTransformation::recursive>::transform(s,t);
-      }
+      static transformed_type transform(const SourceTree& s, const Transformation& t = Transformation());
 
       //! Apply transformation to an existing tree s.
-      static transformed_type transform(const SourceTree& s, Transformation& t)
-      {
-        return TransformTree<SourceTree,Transformation,NodeTag<SourceTree>,NodeTransformation::recursive>::transform(s,t);
-      }
+      static transformed_type transform(const SourceTree& s, Transformation& t);
 
       //! Apply transformation to an existing tree s.
-      static transformed_type transform(std::shared_ptr<const SourceTree> sp, const Transformation& t = Transformation())
-      {
-        return TransformTree<SourceTree,Transformation,NodeTag<SourceTree>,NodeTransformation::recursive>::transform(sp,t);
-      }
+      static transformed_type transform(std::shared_ptr<const SourceTree> sp, const Transformation& t = Transformation());
 
       //! Apply transformation to an existing tree s.
-      static transformed_type transform(std::shared_ptr<const SourceTree> sp, Transformation& t)
-      {
-        return TransformTree<SourceTree,Transformation,NodeTag<SourceTree>,NodeTransformation::recursive>::transform(sp,t);
-      }
+      static transformed_type transform(std::shared_ptr<const SourceTree> sp, Transformation& t);
 
       //! Apply transformation to storage type of an existing tree, returning a heap-allocated storage type
       //! instance of the transformed tree.
-      static transformed_storage_type transform_storage(std::shared_ptr<const SourceTree> sp, const Transformation& t = Transformation())
-      {
-        return TransformTree<SourceTree,Transformation,NodeTag<SourceTree>,NodeTransformation::recursive>::transform_storage(sp,t);
-      }
+      static transformed_storage_type transform_storage(std::shared_ptr<const SourceTree> sp, const Transformation& t = Transformation());
 
       //! Apply transformation to storage type of an existing tree, returning a heap-allocated storage type
       //! instance of the transformed tree.
-      static transformed_storage_type transform_storage(std::shared_ptr<const SourceTree> sp, Transformation& t)
-      {
-        return TransformTree<SourceTree,Transformation,NodeTag<SourceTree>,NodeTransformation::recursive>::transform_storage(sp,t);
-      }
-
+      static transformed_storage_type transform_storage(std::shared_ptr<const SourceTree> sp, Transformation& t);
 
     };
 
-#ifndef DOXYGEN // internal per-node implementations of the transformation algorithm
+#ifndef DOXYGEN
+
+    // The member functions are defined outside of the class, such that they are not
+    // implicitly inline and an explicit instantiation declaration
+    //   extern template TransformTree<SourceTree,Transformation>::transformed_type
+    //     TransformTree<SourceTree,Transformation>::transform(const SourceTree&, const Transformation&);
+    // suppresses their instantiation, see dune_typetree_add_instantiations().
+
+    template<typename SourceTree, typename Transformation, typename Tag, bool recursive>
+    auto TransformTree<SourceTree,Transformation,Tag,recursive>::transform(const SourceTree& s, const Transformation& t)
+      -> transformed_type
+    {
+      return TransformTree<SourceTree,Transformation,NodeTag<SourceTree>,NodeTransformation::recursive>::transform(s,t);
+    }
+
+    template<typename SourceTree, typename Transformation, typename Tag, bool recursive>
+    auto TransformTree<SourceTree,Transformation,Tag,recursive>::transform(const SourceTree& s, Transformation& t)
+      -> transformed_type
+    {
+      return TransformTree<SourceTree,Transformation,NodeTag<SourceTree>,NodeTransformation::recursive>::transform(s,t);
+    }
+
+    template<typename SourceTree, typename Transformation, typename Tag, bool recursive>
+    auto TransformTree<SourceTree,Transformation,Tag,recursive>::transform(std::shared_ptr<const SourceTree> sp, const Transformation& t)
+      -> transformed_type
+    {
+      return TransformTree<SourceTree,Transformation,NodeTag<SourceTree>,NodeTransformation::recursive>::transform(sp,t);
+    }
+
+    template<typename SourceTree, typename Transformation, typename Tag, bool recursive>
+    auto TransformTree<SourceTree,Transformation,Tag,recursive>::transform(std::shared_ptr<const SourceTree> sp, Transformation& t)
+      -> transformed_type
+    {
+      return TransformTree<SourceTree,Transformation,NodeTag<SourceTree>,NodeTransformation::recursive>::transform(sp,t);
+    }
+
+    template<typename SourceTree, typename Transformation, typename Tag, bool recursive>
+    auto TransformTree<SourceTree,Transformation,Tag,recursive>::transform_storage(std::shared_ptr<const SourceTree> sp, const Transformation& t)
+      -> transformed_storage_type
+    {
+      return TransformTree<SourceTree,Transformation,NodeTag<SourceTree>,NodeTransformation::recursive>::transform_storage(sp,t);
+    }
+
+    template<typename SourceTree, typename Transformation, typename Tag, bool recursive>
+    auto TransformTree<SourceTree,Transformation,Tag,recursive>::transform_storage(std::shared_ptr<const SourceTree> sp, Transformation& t)
+      -> transformed_storage_type
+    {
+      return TransformTree<SourceTree,Transformation,NodeTag<SourceTree>,NodeTransformation::recursive>::transform_storage(sp,t);
+    }
+
+    // internal per-node implementations of the transformation algorithm
 
     // handle a leaf node - this is easy
     template<typename S, typename T, bool recursive>
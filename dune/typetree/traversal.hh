@@ -6,12 +6,18 @@
 #ifndef DUNE_TYPETREE_TRAVERSAL_HH
 #define DUNE_TYPETREE_TRAVERSAL_HH
 
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 #include <dune/common/hybridutilities.hh>
-#include <dune/common/std/type_traits.hh>
+#include <dune/common/indices.hh>
+#include <dune/common/typetraits.hh>
 
 #include <dune/typetree/childextraction.hh>
+#include <dune/typetree/fixedcapacitystack.hh>
 #include <dune/typetree/treepath.hh>
 #include <dune/typetree/visitor.hh>
 
@@ -34,18 +40,81 @@ namespace Dune {
 
     namespace Detail {
 
-      // SFINAE template check that Tree has a degree() function and a child() function accepting integer indices
+      // Check that Tree has a degree() function and a child() function accepting integer indices
       template<class Tree>
-      using DynamicTraversalConcept = decltype((
-        std::declval<Tree>().degree(),
-        std::declval<Tree>().child(0u)
-      ));
+      concept DynamicTraversable = requires (Tree& tree) {
+        tree.degree();
+        tree.child(0u);
+      };
 
-      // SFINAE template check that Tree has static (constexpr) function Tree::degree()
+      // Check that Tree has a static (constexpr) function Tree::degree()
       template<class Tree>
-      using StaticTraversalConcept = decltype((
-        std::integral_constant<std::size_t, Tree::degree()>{}
-      ));
+      concept StaticTraversable = requires {
+        std::integral_constant<std::size_t, Tree::degree()>{};
+      };
+
+      /* Invoke a traversal callback and return whether the traversal shall
+       * proceed. Only callbacks returning a TraversalStatus can stop the
+       * traversal, for all others std::true_type is returned, such that
+       * no checks are performed at run time.
+       */
+      template<class F>
+      auto invokeCallback(F&& f)
+      {
+        if constexpr(std::is_same_v<std::decay_t<decltype(f())>, TraversalStatus>)
+          return f() == TraversalStatus::proceed;
+        else {
+          f();
+          return std::true_type{};
+        }
+      }
+
+      // Invoke the callback only if condition holds
+      template<class F>
+      auto invokeCallbackIf(bool condition, F&& f)
+      {
+        using Result = decltype(invokeCallback(f));
+        if (condition)
+          return invokeCallback(f);
+        return Result(std::true_type{});
+      }
+
+      /* Evaluate the passed steps of a traversal in order, until one of them
+       * returns false. Returns std::true_type if none of the steps can stop
+       * the traversal, and whether all steps have been completed otherwise.
+       */
+      template<class... Steps>
+      auto proceedWith(Steps&&... steps)
+      {
+        if constexpr((std::is_same_v<decltype(steps()), std::true_type> && ...)) {
+          (steps(), ...);
+          return std::true_type{};
+        } else
+          return bool((steps() && ...));
+      }
+
+      // Call f(i) for all i < n, until f returns false
+      template<class F>
+      auto forEachIndexUntil(std::size_t n, F&& f)
+      {
+        if constexpr(std::is_same_v<decltype(f(std::size_t(0))), std::true_type>) {
+          for (std::size_t i = 0; i < n; ++i)
+            f(i);
+          return std::true_type{};
+        } else {
+          for (std::size_t i = 0; i < n; ++i)
+            if (not f(i))
+              return false;
+          return true;
+        }
+      }
+
+      // Call f(index_constant<i>) for all static indices i, until f returns false
+      template<class F, std::size_t... i>
+      auto forEachIndexUntil(std::index_sequence<i...>, F&& f)
+      {
+        return proceedWith([&]{ return f(index_constant<i>{}); }...);
+      }
 
 
       template<class Tree, TreePathType::Type pathType, class Prefix,
@@ -93,9 +162,9 @@ namespace Dune {
        */
       template<class T, class TreePath, class V,
         std::enable_if_t<std::decay_t<T>::isLeaf, int> = 0>
-      void applyToTree(T&& tree, TreePath treePath, V&& visitor)
+      auto applyToTree(T&& tree, TreePath treePath, V&& visitor)
       {
-        visitor.leaf(tree, treePath);
+        return invokeCallback([&]{ return visitor.leaf(tree, treePath); });
       }
 
       /*
@@ -103,52 +172,236 @@ namespace Dune {
        */
       template<class T, class TreePath, class V,
         std::enable_if_t<not std::decay_t<T>::isLeaf, int> = 0>
-      void applyToTree(T&& tree, TreePath treePath, V&& visitor)
+      auto applyToTree(T&& tree, TreePath treePath, V&& visitor)
       {
         using Tree = std::remove_reference_t<T>;
         using Visitor = std::remove_reference_t<V>;
-        visitor.pre(tree, treePath);
 
         // check which type of traversal is supported by the tree
-        using allowDynamicTraversal = Dune::Std::is_detected<DynamicTraversalConcept,Tree>;
-        using allowStaticTraversal = Dune::Std::is_detected<StaticTraversalConcept,Tree>;
+        constexpr bool allowDynamicTraversal = DynamicTraversable<Tree>;
+        constexpr bool allowStaticTraversal = StaticTraversable<Tree>;
 
         // the tree must support either dynamic or static traversal
-        static_assert(allowDynamicTraversal::value || allowStaticTraversal::value);
+        static_assert(allowDynamicTraversal || allowStaticTraversal);
 
         // the visitor may specify preferred dynamic traversal
         using preferDynamicTraversal = std::bool_constant<Visitor::treePathType == TreePathType::dynamic>;
 
-        // create a dynamic or static index range
+        // use dynamic or static child indices
         auto indices = [&]{
-          if constexpr(preferDynamicTraversal::value && allowDynamicTraversal::value)
-            return Dune::range(std::size_t(tree.degree()));
+          if constexpr((preferDynamicTraversal::value && allowDynamicTraversal) || not allowStaticTraversal)
+            return std::size_t(tree.degree());
           else
-            return Dune::range(tree.degree());
+            return std::make_index_sequence<Tree::degree()>{};
         }();
 
-        if constexpr(allowDynamicTraversal::value || allowStaticTraversal::value) {
-          Hybrid::forEach(indices, [&](auto i) {
+        auto visitChild = [&](auto i) {
+          auto&& child = tree.child(i);
+          using Child = std::decay_t<decltype(child)>;
+
+          return proceedWith(
+            [&]{ return invokeCallback([&]{ return visitor.beforeChild(tree, child, treePath, i); }); },
+            // This requires that visitor.in(...) can always be instantiated,
+            // even if there's a single child only.
+            [&]{ return invokeCallbackIf(i>0, [&]{ return visitor.in(tree, treePath); }); },
+            [&]{
+              if constexpr(Visitor::template VisitChild<Tree,Child,TreePath>::value) {
+                auto childTreePath = Dune::TypeTree::push_back(treePath, i);
+                return applyToTree(child, childTreePath, visitor);
+              } else
+                return std::true_type{};
+            },
+            [&]{ return invokeCallback([&]{ return visitor.afterChild(tree, child, treePath, i); }); });
+        };
+
+        return proceedWith(
+          [&]{ return invokeCallback([&]{ return visitor.pre(tree, treePath); }); },
+          [&]{ return forEachIndexUntil(indices, visitChild); },
+          [&]{ return invokeCallback([&]{ return visitor.post(tree, treePath); }); });
+      }
+
+      // Upper bound for the length of tree paths in Tree, including the root node
+      template<class Tree>
+      constexpr std::size_t maxDepth()
+      {
+        if constexpr (Tree::isLeaf)
+          return 1;
+        else if constexpr (requires { typename Tree::ChildType; })
+          return 1 + maxDepth<typename Tree::ChildType>();
+        else
+          return unpackIntegerSequence([](auto... i) {
+            std::size_t depth = 0;
+            ((depth = std::max(depth, maxDepth<TypeTree::Child<Tree,i>>())), ...);
+            return 1 + depth;
+          }, std::make_index_sequence<Tree::degree()>{});
+      }
+
+      /* Variant of applyToTree for visitors with TreePathType::inPlace.
+       * Instead of a HybridTreePath, all nodes share the tree path
+       * stored in a single stack, which is pushed and popped around
+       * the visit of a child.
+       */
+      template<class T, class V>
+      auto applyToTreeInPlace(T&& tree, FixedCapacityStackView<std::size_t> treePath, V&& visitor)
+      {
+        using Tree = std::remove_reference_t<T>;
+        using Visitor = std::remove_reference_t<V>;
+        using TreePath = FixedCapacityStackView<std::size_t>;
+        if constexpr(Tree::isLeaf) {
+          return invokeCallback([&]{ return visitor.leaf(tree, treePath); });
+        } else {
+          // check which type of traversal is supported by the tree, prefer dynamic traversal
+          constexpr bool allowDynamicTraversal = DynamicTraversable<Tree>;
+          constexpr bool allowStaticTraversal = StaticTraversable<Tree>;
+
+          // the tree must support either dynamic or static traversal
+          static_assert(allowDynamicTraversal || allowStaticTraversal);
+
+          auto indices = [&]{
+            if constexpr(allowDynamicTraversal)
+              return std::size_t(tree.degree());
+            else
+              return std::make_index_sequence<Tree::degree()>{};
+          }();
+
+          auto visitChild = [&](auto i) {
             auto&& child = tree.child(i);
             using Child = std::decay_t<decltype(child)>;
 
-            visitor.beforeChild(tree, child, treePath, i);
+            return proceedWith(
+              [&]{ return invokeCallback([&]{ return visitor.beforeChild(tree, child, treePath, i); }); },
+              [&]{ return invokeCallbackIf(i>0, [&]{ return visitor.in(tree, treePath); }); },
+              [&]{
+                if constexpr(Visitor::template VisitChild<Tree,Child,TreePath>::value) {
+                  treePath.push_back(i);
+                  auto proceed = applyToTreeInPlace(child, treePath, visitor);
+                  treePath.pop_back();
+                  return proceed;
+                } else
+                  return std::true_type{};
+              },
+              [&]{ return invokeCallback([&]{ return visitor.afterChild(tree, child, treePath, i); }); });
+          };
+
+          return proceedWith(
+            [&]{ return invokeCallback([&]{ return visitor.pre(tree, treePath); }); },
+            [&]{ return forEachIndexUntil(indices, visitChild); },
+            [&]{ return invokeCallback([&]{ return visitor.post(tree, treePath); }); });
+        }
+      }
 
-            // This requires that visitor.in(...) can always be instantiated,
-            // even if there's a single child only.
-            if (i>0)
-              visitor.in(tree, treePath);
+      /* Number of nested levels of power nodes in Tree, if Tree is a chain of
+       * power nodes ending in leaf nodes, where all power nodes but the outermost
+       * one have a static degree. Returns 0 if Tree is not such a chain.
+       * All leaves of such a tree can be enumerated by a single flat loop.
+       */
+      template<class Tree, bool outermost = true>
+      constexpr std::size_t uniformPowerChainDepth()
+      {
+        if constexpr (not Tree::isPower or not requires { typename Tree::ChildType; })
+          return 0;
+        else if constexpr (not DynamicTraversable<Tree>)
+          return 0;
+        else if constexpr (not outermost and not StaticTraversable<Tree>)
+          return 0;
+        else {
+          using ChildType = typename Tree::ChildType;
+          if constexpr (ChildType::isLeaf)
+            return 1;
+          else {
+            constexpr std::size_t childDepth = uniformPowerChainDepth<ChildType,false>();
+            return childDepth > 0 ? 1 + childDepth : 0;
+          }
+        }
+      }
+
+      // The static degrees of the levels of a uniform power chain. The degree of
+      // the outermost level may be dynamic and is set to 0.
+      template<class Tree, std::size_t depth = uniformPowerChainDepth<Tree>()>
+      constexpr std::array<std::size_t,depth> uniformPowerChainExtents()
+      {
+        std::array<std::size_t,depth> extents{};
+        if constexpr (depth > 1) {
+          auto childExtents = uniformPowerChainExtents<typename Tree::ChildType,depth-1>();
+          for (std::size_t l = 1; l < depth; ++l)
+            extents[l] = childExtents[l-1];
+          extents[1] = Tree::ChildType::degree();
+        }
+        return extents;
+      }
 
-            constexpr bool visitChild = Visitor::template VisitChild<Tree,Child,TreePath>::value;
-            if constexpr(visitChild) {
-              auto childTreePath = Dune::TypeTree::push_back(treePath, i);
-              applyToTree(child, childTreePath, visitor);
-            }
+      // The number of leaves below each child of the outermost node of a uniform power chain
+      template<class Tree>
+      constexpr std::size_t uniformPowerChainInnerSize()
+      {
+        auto extents = uniformPowerChainExtents<Tree>();
+        std::size_t size = 1;
+        for (std::size_t l = 1; l < extents.size(); ++l)
+          size *= extents[l];
+        return size;
+      }
 
-            visitor.afterChild(tree, child, treePath, i);
+      // Pointers to the nodes on the path to a leaf of a uniform power chain, excluding the root
+      template<class Node, std::size_t depth>
+      auto uniformPowerChainNodes()
+      {
+        using Child = std::remove_reference_t<decltype(std::declval<Node&>().child(0u))>;
+        if constexpr (depth == 1)
+          return std::tuple<Child*>{};
+        else
+          return std::tuple_cat(std::tuple<Child*>{}, uniformPowerChainNodes<Child,depth-1>());
+      }
+
+      /* Visit all leaves of a uniform power chain in a single flat loop.
+       * The multi-index of the current leaf is advanced like an odometer,
+       * and the tree path of each leaf is created directly from it, with
+       * the same type as in the recursive dynamic traversal. The nodes on
+       * the path to the current leaf are kept, and only those below the
+       * highest changed digit of the multi-index are looked up again.
+       */
+      template<class T, class TreePath, class LeafFunc>
+      auto forEachLeafOfUniformPowerChain(T&& tree, TreePath treePath, LeafFunc&& leafFunc)
+      {
+        using Tree = std::decay_t<T>;
+        constexpr std::size_t depth = uniformPowerChainDepth<Tree>();
+        constexpr auto extents = uniformPowerChainExtents<Tree>();
+        constexpr std::size_t innerSize = uniformPowerChainInnerSize<Tree>();
+
+        std::array<std::size_t,depth> index{};
+        auto nodes = uniformPowerChainNodes<std::remove_reference_t<T>,depth>();
+
+        // look up the nodes on the levels from,...,depth-1 of the path
+        auto update = [&](std::size_t from) {
+          Hybrid::forEach(std::make_index_sequence<depth>{}, [&](auto l) {
+            if (l < from)
+              return;
+            if constexpr (l == 0)
+              std::get<0>(nodes) = &tree.child(index[0]);
+            else
+              std::get<l>(nodes) = &std::get<l-1>(nodes)->child(index[l]);
           });
-        }
-        visitor.post(tree, treePath);
+        };
+
+        const std::size_t degree = tree.degree();
+        if (degree > 0)
+          update(0);
+        return forEachIndexUntil(degree * innerSize, [&](std::size_t) {
+          auto proceed = unpackIntegerSequence([&](auto... l) {
+            return invokeCallback([&]{
+              return leafFunc(*std::get<depth-1>(nodes), join(treePath, hybridTreePath(index[l]...)));
+            });
+          }, std::make_index_sequence<depth>{});
+
+          // advance the multi-index, the innermost level runs fastest
+          std::size_t l = depth-1;
+          while (l > 0 && ++index[l] == extents[l])
+            index[l--] = 0;
+          if (l == 0)
+            ++index[0];
+          if (index[0] < degree)
+            update(l);
+          return proceed;
+        });
       }
 
       /* Traverse tree and visit each node. The signature is the same
@@ -160,36 +413,94 @@ namespace Dune {
        * by passing an empty treePath.
        */
       template<class T, class TreePath, class PreFunc, class LeafFunc, class PostFunc>
-      void forEachNode(T&& tree, TreePath treePath, PreFunc&& preFunc, LeafFunc&& leafFunc, PostFunc&& postFunc)
+      auto forEachNode(T&& tree, TreePath treePath, PreFunc&& preFunc, LeafFunc&& leafFunc, PostFunc&& postFunc)
       {
         using Tree = std::decay_t<T>;
+        using visitLeafsOnly = std::conjunction<
+          std::is_same<std::decay_t<PreFunc>,NoOp>,
+          std::is_same<std::decay_t<PostFunc>,NoOp>>;
         if constexpr(Tree::isLeaf) {
-          leafFunc(tree, treePath);
+          return invokeCallback([&]{ return leafFunc(tree, treePath); });
+        } else if constexpr(visitLeafsOnly::value && (uniformPowerChainDepth<Tree>() > 1)) {
+          // Nested power nodes visiting leaves only: use a single flat loop
+          return forEachLeafOfUniformPowerChain(tree, treePath, leafFunc);
         } else {
-          preFunc(tree, treePath);
+          // check which type of traversal is supported by the tree, prefer dynamic traversal
+          constexpr bool allowDynamicTraversal = DynamicTraversable<Tree>;
+          constexpr bool allowStaticTraversal = StaticTraversable<Tree>;
+
+          // the tree must support either dynamic or static traversal
+          static_assert(allowDynamicTraversal || allowStaticTraversal);
+
+          auto indices = [&]{
+            if constexpr(allowDynamicTraversal)
+              return std::size_t(tree.degree());
+            else
+              return std::make_index_sequence<Tree::degree()>{};
+          }();
+
+          return proceedWith(
+            [&]{ return invokeCallback([&]{ return preFunc(tree, treePath); }); },
+            [&]{
+              return forEachIndexUntil(indices, [&](auto i) {
+                auto childTreePath = Dune::TypeTree::push_back(treePath, i);
+                return forEachNode(tree.child(i), childTreePath, preFunc, leafFunc, postFunc);
+              });
+            },
+            [&]{ return invokeCallback([&]{ return postFunc(tree, treePath); }); });
+        }
+      }
+
+      /* Traverse the subtrees accepted by pred and visit their leafs.
+       * If pred returns a std::integral_constant<bool,...> for some node, the
+       * decision is taken from the return type only, and rejected subtrees are
+       * not instantiated at all.
+       */
+      template<class T, class TreePath, class Pred, class LeafFunc>
+      auto forEachLeafNodeIf(T&& tree, TreePath treePath, Pred&& pred, LeafFunc&& leafFunc);
 
+      template<class T, class TreePath, class Pred, class LeafFunc>
+      auto forEachAcceptedLeafNode(T&& tree, TreePath treePath, Pred&& pred, LeafFunc&& leafFunc)
+      {
+        using Tree = std::decay_t<T>;
+        if constexpr(Tree::isLeaf) {
+          return invokeCallback([&]{ return leafFunc(tree, treePath); });
+        } else {
           // check which type of traversal is supported by the tree, prefer dynamic traversal
-          using allowDynamicTraversal = Dune::Std::is_detected<DynamicTraversalConcept,Tree>;
-          using allowStaticTraversal = Dune::Std::is_detected<StaticTraversalConcept,Tree>;
+          constexpr bool allowDynamicTraversal = DynamicTraversable<Tree>;
+          constexpr bool allowStaticTraversal = StaticTraversable<Tree>;
 
           // the tree must support either dynamic or static traversal
-          static_assert(allowDynamicTraversal::value || allowStaticTraversal::value);
-
-          if constexpr(allowDynamicTraversal::value) {
-            // Specialization for dynamic traversal
-            for (std::size_t i = 0; i < tree.degree(); ++i) {
-              auto childTreePath = Dune::TypeTree::push_back(treePath, i);
-              forEachNode(tree.child(i), childTreePath, preFunc, leafFunc, postFunc);
-            }
-          } else if constexpr(allowStaticTraversal::value) {
-            // Specialization for static traversal
-            auto indices = std::make_index_sequence<Tree::degree()>{};
-            Hybrid::forEach(indices, [&](auto i) {
-              auto childTreePath = Dune::TypeTree::push_back(treePath, i);
-              forEachNode(tree.child(i), childTreePath, preFunc, leafFunc, postFunc);
-            });
-          }
-          postFunc(tree, treePath);
+          static_assert(allowDynamicTraversal || allowStaticTraversal);
+
+          auto indices = [&]{
+            if constexpr(allowDynamicTraversal)
+              return std::size_t(tree.degree());
+            else
+              return std::make_index_sequence<Tree::degree()>{};
+          }();
+
+          return forEachIndexUntil(indices, [&](auto i) {
+            auto childTreePath = Dune::TypeTree::push_back(treePath, i);
+            return forEachLeafNodeIf(tree.child(i), childTreePath, pred, leafFunc);
+          });
+        }
+      }
+
+      template<class T, class TreePath, class Pred, class LeafFunc>
+      auto forEachLeafNodeIf(T&& tree, TreePath treePath, Pred&& pred, LeafFunc&& leafFunc)
+      {
+        using Decision = std::decay_t<decltype(pred(tree, treePath))>;
+        if constexpr(IsIntegralConstant<Decision>::value) {
+          if constexpr(bool(Decision::value))
+            return forEachAcceptedLeafNode(tree, treePath, pred, leafFunc);
+          else
+            return std::true_type{};
+        } else {
+          using Result = decltype(forEachAcceptedLeafNode(tree, treePath, pred, leafFunc));
+          if (pred(tree, treePath))
+            return forEachAcceptedLeafNode(tree, treePath, pred, leafFunc);
+          return Result(std::true_type{});
         }
       }
 
@@ -228,8 +539,19 @@ namespace Dune {
      * or non-const (if the compiler supports rvalue references, they may even be a non-const temporary).
      *
      * \note The visitor must implement the interface laid out by DefaultVisitor (most easily achieved by
-     *       inheriting from it) and specify the required type of tree traversal (static or dynamic) by
-     *       inheriting from either StaticTraversal or DynamicTraversal.
+     *       inheriting from it) and specify the required type of tree traversal (static, dynamic or in-place)
+     *       by inheriting from either StaticTraversal, DynamicTraversal or InPlaceTraversal.
+     *
+     * The traversal can be ended early by returning TraversalStatus::stop from any method of the visitor.
+     * In this case, no further methods are called, including the `afterChild()` and `post()` methods
+     * of the nodes whose visit has already been started.
+     *
+     * For a given tree type and visitor type, the traversal can be compiled once in a dedicated
+     * translation unit by an explicit instantiation and declared `extern` in all others:
+     * \code
+     * extern template void Dune::TypeTree::applyToTree(MyTree&, MyVisitor&);
+     * \endcode
+     * The CMake function `dune_typetree_add_instantiations()` generates both.
      *
      * \param tree    The tree the visitor will be applied to.
      * \param visitor The visitor to apply to the tree.
@@ -237,7 +559,12 @@ namespace Dune {
     template<typename Tree, typename Visitor>
     void applyToTree(Tree&& tree, Visitor&& visitor)
     {
-      Detail::applyToTree(tree, hybridTreePath(), visitor);
+      if constexpr(std::decay_t<Visitor>::treePathType == TreePathType::inPlace) {
+        FixedCapacityStack<std::size_t, Detail::maxDepth<std::decay_t<Tree>>()> stack;
+        FixedCapacityStackView<std::size_t>& treePath = stack;
+        Detail::applyToTreeInPlace(tree, treePath, visitor);
+      } else
+        Detail::applyToTree(tree, hybridTreePath(), visitor);
     }
 
     /**
@@ -250,6 +577,10 @@ namespace Dune {
      * All callback functions are called with the
      * node and corresponding treepath as arguments.
      *
+     * Each callback may return a TraversalStatus. Returning
+     * TraversalStatus::stop ends the traversal immediately,
+     * without calling the postNodeFunc of the enclosing nodes.
+     *
      * \param tree The tree to traverse
      * \param preNodeFunc This function is called for each inner node
      * \param leafNodeFunc This function is called for each leaf node
@@ -266,6 +597,7 @@ namespace Dune {
      *
      * The passed callback function is called with the
      * node and corresponding treepath as arguments.
+     * The traversal ends early if it returns TraversalStatus::stop.
      *
      * \param tree The tree to traverse
      * \param nodeFunc This function is called for each node
@@ -281,6 +613,17 @@ namespace Dune {
      *
      * The passed callback function is called with the
      * node and corresponding treepath as arguments.
+     * The traversal ends early if it returns TraversalStatus::stop.
+     *
+     * \code{.cc}
+     * // find the first leaf satisfying some condition
+     * forEachLeafNode(tree, [&](auto&& leaf, auto treePath) {
+     *   if (not condition(leaf))
+     *     return TraversalStatus::proceed;
+     *   found = true;
+     *   return TraversalStatus::stop;
+     * });
+     * \endcode
      *
      * \param tree The tree to traverse
      * \param leafFunc This function is called for each leaf node
@@ -291,6 +634,40 @@ namespace Dune {
       Detail::forEachNode(tree, hybridTreePath(), NoOp{}, leafFunc, NoOp{});
     }
 
+    /**
+     * \brief Traverse the subtrees selected by a predicate and visit their leaf nodes
+     *
+     * Before a node is entered, the predicate is called with the node and its
+     * tree path. If it returns false, the whole subtree rooted in this node is
+     * skipped: no child paths are computed and no callbacks are invoked for it.
+     * The root node is subject to the predicate as well. The traversal ends early
+     * if leafFunc returns TraversalStatus::stop.
+     *
+     * The decision can be made at compile time by returning `std::true_type` or
+     * `std::false_type` (or any other `std::integral_constant`). In this case, the
+     * predicate is not invoked; its return type alone decides, and rejected subtrees
+     * are not even instantiated. This is the case if the decision depends only on the
+     * node type and on static entries of the tree path:
+     *
+     * \code{.cc}
+     * // skip all leafs below power nodes
+     * forEachLeafNode(tree,
+     *   [](auto&& node, auto treePath) {
+     *     return std::bool_constant<not std::decay_t<decltype(node)>::isPower>{};
+     *   },
+     *   [&](auto&& leaf, auto treePath) { ... });
+     * \endcode
+     *
+     * \param tree      The tree to traverse
+     * \param predicate This function is called for each node and returns whether to visit its subtree
+     * \param leafFunc  This function is called for each leaf node accepted by the predicate
+     */
+    template<class Tree, class Predicate, class LeafFunc>
+    void forEachLeafNode(Tree&& tree, Predicate&& predicate, LeafFunc&& leafFunc)
+    {
+      Detail::forEachLeafNodeIf(tree, hybridTreePath(), predicate, leafFunc);
+    }
+
     //! \} group Tree Traversal
 
   } // namespace TypeTree
@@ -78,6 +78,9 @@ namespace Dune {
        * \param startValue The initial value for the result.
        *
        * \returns The value obtained by combining the individual results for all leafs.
+       *
+       * \note Every call traverses the whole tree. If the reduction is needed repeatedly for
+       *       a tree that only changes in parts, or for several subtrees, use a SubtreeCache.
        */
     template<typename ResultType, typename Tree, typename F, typename R>
     ResultType reduceOverLeafs(const Tree& tree, F functor, R reduction, ResultType startValue)
@@ -9,13 +9,18 @@
 #include <type_traits>
 #include <utility>
 #include <functional>
+#include <algorithm>
 #include <array>
+#include <span>
+#include <vector>
 
+#include <dune/common/alignedallocator.hh>
 #include <dune/common/indices.hh>
 #include <dune/common/hybridutilities.hh>
 #include <dune/common/rangeutilities.hh>
 #include <dune/common/tuplevector.hh>
 
+#include <dune/typetree/traversal.hh>
 #include <dune/typetree/treepath.hh>
 
 namespace Dune {
@@ -226,6 +231,101 @@ namespace Dune {
         return TreeContainerVectorBackend<std::decay_t<Container>>(std::forward<Container>(container));
       }
 
+      /*
+       * \brief Store consecutive numbers for the leafs of the tree in the order of forEachLeafNode()
+       *
+       * \returns The number of leafs
+       */
+      template<class Indexer, class Tree>
+      std::size_t enumerateLeafs(Indexer& indexer, const Tree& tree)
+      {
+        std::size_t size = 0;
+        forEachLeafNode(tree, [&](auto&&, auto treePath) {
+          indexer[treePath] = size++;
+        });
+        return size;
+      }
+
+      /*
+       * \brief Store the values of all leafs in a single contiguous buffer
+       *
+       * The values are stored in the order of forEachLeafNode(). The position of
+       * each leaf within the buffer is looked up in the Indexer, a nested container
+       * of indices with the same structure as the tree.
+       */
+      template<class Value, class Indexer>
+      class FlatTreeContainer
+      {
+        // align the buffer to a cache line, which also fits all SIMD registers
+        static constexpr int alignment = std::max<int>(alignof(Value), 64);
+
+      public:
+
+        using Storage = std::vector<Value, Dune::AlignedAllocator<Value,alignment>>;
+
+        //! Create a container for the leafs of the tree with all values initialized to value
+        template<class Tree>
+        FlatTreeContainer(const Tree& tree, const Value& value) :
+          indexer_(tree)
+        {
+          values_.assign(enumerateLeafs(indexer_, tree), value);
+        }
+
+        template<class... T>
+        const Value& operator[](const HybridTreePath<T...>& path) const
+        {
+          return values_[indexer_[path]];
+        }
+
+        template<class... T>
+        Value& operator[](const HybridTreePath<T...>& path)
+        {
+          return values_[indexer_[path]];
+        }
+
+        //! The position of the value of the leaf at the given path within values()
+        template<class... T>
+        std::size_t index(const HybridTreePath<T...>& path) const
+        {
+          return indexer_[path];
+        }
+
+        //! Resize the container depending on the degree of the tree nodes, all values are reset to value
+        template<class Tree>
+        void resize(const Tree& tree, const Value& value = Value{})
+        {
+          indexer_.resize(tree);
+          values_.assign(enumerateLeafs(indexer_, tree), value);
+        }
+
+        //! The number of leafs
+        std::size_t size() const
+        {
+          return values_.size();
+        }
+
+        //! The values of all leafs in a contiguous, aligned range
+        std::span<const Value> values() const
+        {
+          return values_;
+        }
+
+        //! The values of all leafs in a contiguous, aligned range
+        std::span<Value> values()
+        {
+          return values_;
+        }
+
+        const Indexer& indexer() const
+        {
+          return indexer_;
+        }
+
+      private:
+        Indexer indexer_;
+        Storage values_;
+      };
+
       /*
        * \brief A simple lambda for creating default constructible values from a node
        *
@@ -293,6 +393,37 @@ namespace Dune {
       return makeTreeContainer(tree, [](const auto&) {return Value{};});
     }
 
+    /**
+     * \brief Create a container storing the values of all leafs in a single flat buffer
+     *
+     * In contrast to makeTreeContainer, which mirrors the tree by nested std::array's,
+     * std::vector's and Dune::TupleVector's, the values of all leafs are of the same type
+     * Value and are stored contiguously in a single buffer aligned to 64 bytes, in the order
+     * of forEachLeafNode(). The returned object provides operator[] access using a
+     * HybridTreePath like the container created by makeTreeContainer. Additionally,
+     * values() returns a std::span over all values, such that operations on all
+     * leafs can be written as a single loop, which the compiler may vectorize:
+     *
+     * \code{.cc}
+     * auto container = makeFlatTreeContainer<double>(tree);
+     * double sum = 0;
+     * for (double v : container.values())
+     *   sum += v;
+     * \endcode
+     *
+     * \tparam Value Type of the values to be stored for the leafs.
+     * \param tree The tree which should be mapped to a container
+     * \param value The initial value of all leafs
+     *
+     * \returns A flat container for the leafs of the tree
+     */
+    template<class Value, class Tree>
+    auto makeFlatTreeContainer(const Tree& tree, const Value& value = Value{})
+    {
+      using Indexer = std::decay_t<decltype(makeTreeContainer<std::size_t>(tree))>;
+      return Detail::FlatTreeContainer<Value,Indexer>(tree, value);
+    }
+
     /**
      * \brief Alias to container type generated by makeTreeContainer for given tree type and uniform value type
      */
@@ -305,6 +436,12 @@ namespace Dune {
     template<template<class Node> class LeafToValue, class Tree>
     using TreeContainer = std::decay_t<decltype(makeTreeContainer(std::declval<const Tree&>(), std::declval<Detail::LeafToDefaultConstructibleValue<LeafToValue>>()))>;
 
+    /**
+     * \brief Alias to container type generated by makeFlatTreeContainer for given tree type and value type
+     */
+    template<class Value, class Tree>
+    using FlatTreeContainer = std::decay_t<decltype(makeFlatTreeContainer<Value>(std::declval<const Tree&>()))>;
+
     //! \} group TypeTree
 
   } // namespace TypeTree
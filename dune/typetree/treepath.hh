@@ -70,7 +70,13 @@ namespace Dune {
     //! \{
 
     namespace TreePathType {
-      enum Type { fullyStatic, dynamic };
+      //! Representation of the tree path handed to a visitor during traversal.
+      /**
+       * - `fullyStatic`: a `HybridTreePath` with compile time indices only.
+       * - `dynamic`: a `HybridTreePath` with run time indices for nodes supporting dynamic child access.
+       * - `inPlace`: a single `FixedCapacityStackView<std::size_t>` that is updated in place.
+       */
+      enum Type { fullyStatic, dynamic, inPlace };
     }
 
     /**
@@ -31,67 +31,29 @@ namespace Dune {
     template<typename T>
     struct has_node_tag
     {
-      struct yes { char dummy[1]; };
-      struct no  { char dummy[2]; };
-
-      template<typename X>
-      static yes test(NodeTag<X> *);
-      template<typename X>
-      static no  test(...);
-
       /** @brief True if class T defines a NodeTag. */
-      constexpr static bool value = sizeof(test<T>(0)) == sizeof(yes);
+      constexpr static bool value = requires { typename NodeTag<T>; };
     };
 
     template<typename T, typename V>
     struct has_node_tag_value
     {
-      template<int N>
-      struct maybe { char dummy[N+1]; };
-      struct yes { char dummy[2]; };
-      struct no  { char dummy[1]; };
-
-      template<typename X>
-      static maybe<std::is_base_of<V, NodeTag<X>>::value>
-      test(NodeTag<X> * a);
-      template<typename X>
-      static no test(...);
-
       /** @brief True if class T defines a NodeTag of type V. */
-      constexpr static bool value = sizeof(test<T>(0)) == sizeof(yes);
+      constexpr static bool value = requires { requires std::is_base_of_v<V, NodeTag<T>>; };
     };
 
     template<typename T>
     struct has_implementation_tag
     {
-      struct yes { char dummy[1]; };
-      struct no  { char dummy[2]; };
-
-      template<typename X>
-      static yes test(ImplementationTag<X> *);
-      template<typename X>
-      static no  test(...);
-
       /** @brief True if class T defines an ImplementationTag. */
-      constexpr static bool value = sizeof(test<T>(0)) == sizeof(yes);
+      constexpr static bool value = requires { typename ImplementationTag<T>; };
     };
 
     template<typename T, typename V>
     struct has_implementation_tag_value
     {
-      template<int N>
-      struct maybe { char dummy[N+1]; };
-      struct yes { char dummy[2]; };
-      struct no  { char dummy[1]; };
-
-      template<typename X>
-      static maybe<std::is_base_of<V, ImplementationTag<X>>::value>
-      test(ImplementationTag<X> * a);
-      template<typename X>
-      static no test(...);
-
       /** @brief True if class T defines an ImplementationTag of type V. */
-      constexpr static bool value = sizeof(test<T>(0)) == sizeof(yes);
+      constexpr static bool value = requires { requires std::is_base_of_v<V, ImplementationTag<T>>; };
     };
 
     template<typename>
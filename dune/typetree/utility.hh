@@ -63,10 +63,13 @@ namespace Dune {
        *
        * @param binary_op  Binary functor (discarded)
        * @param arg        Final result of the fold expansion
-       * @return constexpr decltype(auto)  Final result of the fold expansion
+       * @return constexpr auto  Final result of the fold expansion
+       *
+       * @note The result is returned by value, as arg usually refers to a temporary
+       *       created by the calling fold step, which does not outlive the call.
        */
       template<class BinaryOp, class Arg>
-      constexpr decltype(auto)
+      constexpr auto
       left_fold(const BinaryOp& binary_op, Arg&& arg)
       {
         return std::forward<Arg>(arg);
@@ -17,6 +17,24 @@ namespace Dune {
      *  \{
      */
 
+    //! Result of a traversal callback, deciding whether the traversal continues.
+    /**
+     * The methods of a visitor applied by applyToTree() and the callbacks passed to
+     * forEachNode() and forEachLeafNode() may return a TraversalStatus instead of `void`.
+     * Returning TraversalStatus::stop ends the whole traversal immediately: no further
+     * callback is invoked, in particular the pending calls of `afterChild()` and `post()`
+     * for the ancestors of the current node are skipped.
+     *
+     * Whether a callback can stop the traversal is decided by its return type. Callbacks
+     * returning `void` never stop it, and if none of the callbacks returns a TraversalStatus,
+     * the traversal does not perform any additional run time checks.
+     */
+    enum class TraversalStatus
+    {
+      proceed, //!< Continue the traversal.
+      stop     //!< End the traversal without invoking any further callbacks.
+    };
+
     //! Visitor interface and base class for TypeTree visitors.
     /**
      * DefaultVisitor defines the interface for visitors that can be applied to a TypeTree
@@ -42,6 +60,8 @@ namespace Dune {
      * DirectChildrenVisitor. The latter two inherit from both DefaultVisitor and one of the two mixin classes
      * and can thus be used as convenient base classes.
      *
+     * Each method may return a TraversalStatus instead of `void` to stop the traversal early.
+     *
      * \note This class can also be used as a convenient base class if the implemented visitor
      *       only needs to act on some of the possible callback sites, avoiding a lot of boilerplate code.
      */
@@ -428,6 +448,25 @@ namespace Dune {
       static const TreePathType::Type treePathType = TreePathType::dynamic;
     };
 
+    //! Mixin base class for visitors that only need a dynamic TreePath that is updated in place.
+    /**
+     * Instead of creating a new, longer HybridTreePath for every visited child, the
+     * traversal keeps a single stack of run time indices that is pushed and popped in place.
+     * All visitor methods receive a FixedCapacityStackView<std::size_t> to this stack, which
+     * is cheap to copy and can be converted into a DynamicTreePath to take a snapshot.
+     *
+     * \note The view refers to the state of the traversal: it only describes the position of
+     *       the visited node during the call of the visitor method, and it must not be modified
+     *       by the visitor.
+     *
+     * \sa DynamicTraversal
+     */
+    struct InPlaceTraversal
+    {
+      //! Use the in-place tree traversal algorithm.
+      static const TreePathType::Type treePathType = TreePathType::inPlace;
+    };
+
     //! Convenience base class for visiting the entire tree.
     struct TreeVisitor
       : public DefaultVisitor
@@ -0,0 +1,94 @@
+# SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+# SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+
+# Compare two reports of the compile-time benchmark:
+#
+#   cmake -DBASELINE=<report> -DCURRENT=<report> [-DTOLERANCE=1.1] -P comparecompiletime.cmake
+#
+# Prints the ratio current/baseline of the compile time, the peak compiler
+# memory and the object size of every benchmark contained in both reports,
+# and fails if any of them exceeds TOLERANCE.
+
+if(NOT BASELINE OR NOT CURRENT)
+  message(FATAL_ERROR "usage: cmake -DBASELINE=<report> -DCURRENT=<report> [-DTOLERANCE=1.1] -P comparecompiletime.cmake")
+endif()
+if(NOT TOLERANCE)
+  set(TOLERANCE 1.1)
+endif()
+
+# CMake has no floating point arithmetic, so decimal numbers are converted to
+# integers in per mille, e.g. seconds to milliseconds
+function(per_mille value result)
+  string(FIND "${value}" "." dot)
+  if(dot EQUAL -1)
+    set(whole "${value}")
+    set(fraction "")
+  else()
+    string(SUBSTRING "${value}" 0 ${dot} whole)
+    math(EXPR start "${dot} + 1")
+    string(SUBSTRING "${value}" ${start} -1 fraction)
+  endif()
+  if(whole STREQUAL "")
+    set(whole 0)
+  endif()
+  string(SUBSTRING "${fraction}000" 0 3 fraction)
+  math(EXPR value "${whole} * 1000 + 1${fraction} - 1000")
+  set(${result} ${value} PARENT_SCOPE)
+endfunction()
+
+function(read_report file prefix)
+  file(STRINGS "${file}" lines)
+  set(names "")
+  foreach(line IN LISTS lines)
+    string(REPLACE "," ";" fields "${line}")
+    list(LENGTH fields length)
+    if(NOT length EQUAL 4)
+      continue()
+    endif()
+    list(GET fields 0 name)
+    list(GET fields 1 seconds)
+    list(GET fields 2 memory)
+    list(GET fields 3 size)
+    per_mille(${seconds} milliseconds)
+    # later runs of the same benchmark replace earlier ones
+    set(${prefix}_${name}_time ${milliseconds} PARENT_SCOPE)
+    set(${prefix}_${name}_memory ${memory} PARENT_SCOPE)
+    set(${prefix}_${name}_size ${size} PARENT_SCOPE)
+    list(APPEND names ${name})
+  endforeach()
+  list(REMOVE_DUPLICATES names)
+  set(${prefix}_names ${names} PARENT_SCOPE)
+endfunction()
+
+read_report("${BASELINE}" baseline)
+read_report("${CURRENT}" current)
+
+per_mille(${TOLERANCE} limit)
+
+set(failed "")
+foreach(name IN LISTS current_names)
+  if(NOT DEFINED baseline_${name}_time)
+    continue()
+  endif()
+  set(line "${name}:")
+  foreach(quantity time memory size)
+    set(old ${baseline_${name}_${quantity}})
+    set(new ${current_${name}_${quantity}})
+    if(old GREATER 0)
+      math(EXPR ratio "${new} * 1000 / ${old}")
+      math(EXPR whole "${ratio} / 1000")
+      math(EXPR fraction "${ratio} % 1000 + 1000")
+      string(SUBSTRING "${fraction}" 1 3 fraction)
+      string(APPEND line " ${quantity} ${whole}.${fraction}")
+      if(ratio GREATER limit)
+        list(APPEND failed "${name} (${quantity})")
+      endif()
+    endif()
+  endforeach()
+  message(STATUS "${line}")
+endforeach()
+
+if(failed)
+  string(REPLACE ";" ", " failed "${failed}")
+  message(FATAL_ERROR "Compile-time benchmarks exceeding the tolerance of ${TOLERANCE}: ${failed}")
+endif()
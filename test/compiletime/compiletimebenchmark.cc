@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+#include "config.h"
+
+#include <cstddef>
+
+#include "compiletimebenchmark.hh"
+
+// Instantiates a single algorithm for a single synthetic tree, both selected by
+// the build system, e.g. -DBENCHMARK_TREE=WideComposite -DBENCHMARK_SIZE=16
+// -DBENCHMARK_ALGORITHM=applyToTree
+
+#if !defined(BENCHMARK_TREE) || !defined(BENCHMARK_SIZE) || !defined(BENCHMARK_ALGORITHM)
+#error "BENCHMARK_TREE, BENCHMARK_SIZE and BENCHMARK_ALGORITHM must be defined"
+#endif
+
+using Tree = Benchmark::BENCHMARK_TREE<BENCHMARK_SIZE>;
+
+std::size_t benchmark(const Tree& tree)
+{
+  return Benchmark::BENCHMARK_ALGORITHM(tree);
+}
@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+#ifndef DUNE_TYPETREE_TEST_COMPILETIME_COMPILETIMEBENCHMARK_HH
+#define DUNE_TYPETREE_TEST_COMPILETIME_COMPILETIMEBENCHMARK_HH
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include <dune/typetree/accumulate_static.hh>
+#include <dune/typetree/compositenode.hh>
+#include <dune/typetree/dynamicpowernode.hh>
+#include <dune/typetree/leafnode.hh>
+#include <dune/typetree/powernode.hh>
+#include <dune/typetree/simpletransformationdescriptors.hh>
+#include <dune/typetree/transformation.hh>
+#include <dune/typetree/traversal.hh>
+#include <dune/typetree/treecontainer.hh>
+#include <dune/typetree/visitor.hh>
+
+// Synthetic trees and the algorithms instantiated for them by the compile-time
+// benchmark, see CMakeLists.txt in this directory.
+
+namespace Benchmark {
+
+  struct LeafTag {};
+  struct PowerTag {};
+  struct DynamicPowerTag {};
+  struct CompositeTag {};
+
+  // distinct leaf types, such that every child of a composite node has its own type
+  template<int id>
+  struct Leaf
+    : public Dune::TypeTree::LeafNode
+  {
+    typedef LeafTag ImplementationTag;
+  };
+
+  template<typename T, std::size_t k>
+  struct Power
+    : public Dune::TypeTree::PowerNode<T,k>
+  {
+    typedef PowerTag ImplementationTag;
+  };
+
+  template<typename T>
+  struct DynamicPower
+    : public Dune::TypeTree::DynamicPowerNode<T>
+  {
+    typedef DynamicPowerTag ImplementationTag;
+  };
+
+  template<typename... Children>
+  struct Composite
+    : public Dune::TypeTree::CompositeNode<Children...>
+  {
+    typedef CompositeTag ImplementationTag;
+  };
+
+  namespace Impl {
+
+    template<std::size_t... i>
+    auto wideComposite(std::index_sequence<i...>)
+      -> Composite<std::conditional_t<i % 2 == 0, Leaf<i>, Power<Leaf<i>,2>>...>;
+
+    template<std::size_t depth>
+    struct NestedPower
+    {
+      using type = Power<typename NestedPower<depth-1>::type,3>;
+    };
+
+    template<>
+    struct NestedPower<0>
+    {
+      using type = Leaf<0>;
+    };
+
+    template<std::size_t depth>
+    struct MixedPower
+    {
+      using Child = typename MixedPower<depth-1>::type;
+      using type = std::conditional_t<depth % 2 == 0, DynamicPower<Child>, Power<Child,3>>;
+    };
+
+    template<>
+    struct MixedPower<0>
+    {
+      using type = Leaf<0>;
+    };
+
+  } // namespace Impl
+
+  //! Composite node with `width` children, alternating leafs and power nodes of leafs
+  template<std::size_t width>
+  using WideComposite = decltype(Impl::wideComposite(std::make_index_sequence<width>{}));
+
+  //! `depth` nested power nodes of degree 3
+  template<std::size_t depth>
+  using NestedPower = typename Impl::NestedPower<depth>::type;
+
+  //! `depth` nested power nodes, alternating between static and dynamic degree
+  template<std::size_t depth>
+  using MixedPower = typename Impl::MixedPower<depth>::type;
+
+  struct Transformation {};
+
+  struct TransformedLeaf
+    : public Dune::TypeTree::LeafNode
+  {};
+
+  template<typename T, std::size_t k>
+  struct TransformedPower
+    : public Dune::TypeTree::PowerNode<T,k>
+  {
+    explicit TransformedPower(const typename Dune::TypeTree::PowerNode<T,k>::NodeStorage& children)
+      : Dune::TypeTree::PowerNode<T,k>(children)
+    {}
+  };
+
+  template<typename T>
+  struct TransformedDynamicPower
+    : public Dune::TypeTree::DynamicPowerNode<T>
+  {
+    explicit TransformedDynamicPower(const typename Dune::TypeTree::DynamicPowerNode<T>::NodeStorage& children)
+      : Dune::TypeTree::DynamicPowerNode<T>(children)
+    {}
+  };
+
+  template<typename... Children>
+  struct TransformedComposite
+    : public Dune::TypeTree::CompositeNode<Children...>
+  {
+    explicit TransformedComposite(std::shared_ptr<Children>... children)
+      : Dune::TypeTree::CompositeNode<Children...>(children...)
+    {}
+  };
+
+  template<typename S>
+  Dune::TypeTree::SimpleLeafNodeTransformation<S,Transformation,TransformedLeaf>
+  registerNodeTransformation(S*, Transformation*, LeafTag*);
+
+  template<typename S>
+  Dune::TypeTree::SimplePowerNodeTransformation<S,Transformation,TransformedPower>
+  registerNodeTransformation(S*, Transformation*, PowerTag*);
+
+  template<typename S>
+  Dune::TypeTree::SimpleDynamicPowerNodeTransformation<S,Transformation,TransformedDynamicPower>
+  registerNodeTransformation(S*, Transformation*, DynamicPowerTag*);
+
+  template<typename S>
+  Dune::TypeTree::SimpleCompositeNodeTransformation<S,Transformation,TransformedComposite>
+  registerNodeTransformation(S*, Transformation*, CompositeTag*);
+
+  struct LeafCounter
+    : public Dune::TypeTree::TreeVisitor
+    , public Dune::TypeTree::StaticTraversal
+  {
+    template<typename T, typename TreePath>
+    void leaf(T&& t, TreePath treePath)
+    {
+      ++count;
+    }
+
+    std::size_t count = 0;
+  };
+
+  struct LeafCountFunctor
+  {
+    typedef std::size_t result_type;
+
+    template<typename Node, typename TreePath>
+    struct doVisit
+    {
+      static const bool value = Node::isLeaf;
+    };
+
+    template<typename Node, typename TreePath>
+    struct visit
+    {
+      static const result_type result = 1;
+    };
+  };
+
+  // The algorithms, each instantiated for a single tree type per translation unit
+
+  template<typename Tree>
+  std::size_t applyToTree(const Tree& tree)
+  {
+    LeafCounter counter;
+    Dune::TypeTree::applyToTree(tree, counter);
+    return counter.count;
+  }
+
+  template<typename Tree>
+  std::size_t forEachLeafNode(const Tree& tree)
+  {
+    std::size_t count = 0;
+    Dune::TypeTree::forEachLeafNode(tree, [&](auto&& leaf, auto treePath) {
+      ++count;
+    });
+    return count;
+  }
+
+  template<typename Tree>
+  std::size_t leafTreePathTuple(const Tree& tree)
+  {
+    return std::tuple_size_v<decltype(Dune::TypeTree::leafTreePathTuple<Tree>())>;
+  }
+
+  template<typename Tree>
+  std::size_t makeTreeContainer(const Tree& tree)
+  {
+    auto container = Dune::TypeTree::makeTreeContainer<double>(tree);
+    std::size_t count = 0;
+    Dune::TypeTree::forEachLeafNode(tree, [&](auto&& leaf, auto treePath) {
+      container[treePath] = 1.0;
+      count += container[treePath];
+    });
+    return count;
+  }
+
+  template<typename Tree>
+  std::size_t transformTree(const Tree& tree)
+  {
+    auto transformed = Dune::TypeTree::TransformTree<Tree,Transformation>::transform(tree);
+    return std::size_t(transformed.degree());
+  }
+
+  template<typename Tree>
+  std::size_t accumulateValue(const Tree& tree)
+  {
+    return Dune::TypeTree::AccumulateValue<Tree,LeafCountFunctor,Dune::TypeTree::plus<std::size_t>,0>::result;
+  }
+
+} // namespace Benchmark
+
+#endif // DUNE_TYPETREE_TEST_COMPILETIME_COMPILETIMEBENCHMARK_HH
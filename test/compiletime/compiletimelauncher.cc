@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+
+// Compiler launcher of the compile-time benchmark:
+//
+//   compiletimelauncher <report> <name> <repetitions> <compiler> <arguments>...
+//
+// runs the compiler command <repetitions> times and appends a line
+//
+//   <name>,<seconds>,<peak compiler RSS in KiB>,<object size in bytes>
+//
+// to the CSV file <report>. The seconds are the minimal user and system CPU
+// time of the compiler over all repetitions, which is less sensitive to the
+// load of the machine than the wall-clock time. The object file is taken from
+// the -o argument.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Runs the command and returns its exit code, or -1 if it did not exit normally
+int run(std::vector<char*>& command, struct rusage& usage)
+{
+  pid_t pid = fork();
+  if (pid < 0)
+  {
+    std::perror("fork");
+    return -1;
+  }
+  if (pid == 0)
+  {
+    execvp(command[0], command.data());
+    std::perror(command[0]);
+    _exit(127);
+  }
+
+  int status = 0;
+  if (wait4(pid, &status, 0, &usage) < 0)
+  {
+    std::perror("wait4");
+    return -1;
+  }
+  return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 5)
+  {
+    std::fprintf(stderr, "usage: %s <report> <name> <repetitions> <compiler> <arguments>...\n", argv[0]);
+    return 2;
+  }
+
+  const std::string report = argv[1];
+  const std::string name = argv[2];
+  const int repetitions = std::max(std::atoi(argv[3]), 1);
+  std::vector<char*> command(argv + 4, argv + argc);
+  command.push_back(nullptr);
+
+  std::string object;
+  for (int i = 4; i + 1 < argc; ++i)
+    if (std::strcmp(argv[i], "-o") == 0)
+      object = argv[i+1];
+
+  double seconds = std::numeric_limits<double>::max();
+  long memory = 0;
+  for (int r = 0; r < repetitions; ++r)
+  {
+    struct rusage usage;
+    int status = run(command, usage);
+    if (status < 0)
+      return 2;
+    if (status != 0)
+      return status;
+    seconds = std::min(seconds, usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+                       + 1e-6 * (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec));
+    // ru_maxrss is given in KiB on Linux
+    memory = std::max(memory, usage.ru_maxrss);
+  }
+
+  struct stat objectStatus;
+  long long objectSize = -1;
+  if (not object.empty() and stat(object.c_str(), &objectStatus) == 0)
+    objectSize = objectStatus.st_size;
+
+  std::ofstream out(report, std::ios::app);
+  out << name << "," << std::fixed << std::setprecision(3) << seconds << "," << memory << "," << objectSize << std::endl;
+  return out ? 0 : 2;
+}
@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+#ifndef DUNE_TYPETREE_TEST_EXPLICITINSTANTIATIONTREE_HH
+#define DUNE_TYPETREE_TEST_EXPLICITINSTANTIATIONTREE_HH
+
+#include <cstddef>
+
+#include "typetreetestutility.hh"
+#include "typetreetargetnodes.hh"
+
+// The types the traversals and transformations are explicitly instantiated for,
+// see dune_typetree_add_instantiations() in CMakeLists.txt
+
+using ExplicitInstantiationTree = SimpleComposite<SimpleLeaf,SimplePower<SimpleLeaf,3>,SimpleDynamicPower<SimpleLeaf>>;
+
+struct LeafCounter
+  : public Dune::TypeTree::TreeVisitor
+  , public Dune::TypeTree::DynamicTraversal
+{
+  template<typename T, typename TreePath>
+  void leaf(T&& t, TreePath treePath)
+  {
+    ++leafCount;
+  }
+
+  std::size_t leafCount = 0;
+};
+
+#endif // DUNE_TYPETREE_TEST_EXPLICITINSTANTIATIONTREE_HH
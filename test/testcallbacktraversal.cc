@@ -10,6 +10,12 @@
 #include <dune/typetree/powernode.hh>
 #include <dune/typetree/compositenode.hh>
 #include <dune/typetree/traversal.hh>
+#include <dune/typetree/dynamictreepath.hh>
+#include <dune/typetree/leafbatch.hh>
+
+#include <memory>
+#include <span>
+#include <vector>
 
 
 
@@ -155,6 +161,50 @@ private:
 };
 
 
+template<class TraversalType>
+struct PathCollector
+    : Dune::TypeTree::TreeVisitor
+    , TraversalType
+{
+  template<class Node, class TreePath>
+  void pre(Node&& node, TreePath tp) { paths.push_back(tp); }
+
+  template<class Node, class TreePath>
+  void leaf(Node&& node, TreePath tp) { paths.push_back(tp); }
+
+  std::vector<Dune::TypeTree::DynamicTreePath> paths;
+};
+
+
+// Records the visited nodes and stops the traversal at the leaf with the given path
+template<class TraversalType>
+struct StoppingCollector
+    : Dune::TypeTree::TreeVisitor
+    , TraversalType
+{
+  StoppingCollector(Dune::TypeTree::DynamicTreePath stopPath)
+    : stopPath(stopPath)
+  {}
+
+  template<class Node, class TreePath>
+  void pre(Node&& node, TreePath tp) { paths.push_back(tp); }
+
+  template<class Node, class TreePath>
+  Dune::TypeTree::TraversalStatus leaf(Node&& node, TreePath tp)
+  {
+    paths.push_back(tp);
+    return Dune::TypeTree::DynamicTreePath(tp) == stopPath ? Dune::TypeTree::TraversalStatus::stop : Dune::TypeTree::TraversalStatus::proceed;
+  }
+
+  template<class Node, class TreePath>
+  void post(Node&& node, TreePath tp) { ++posts; }
+
+  Dune::TypeTree::DynamicTreePath stopPath;
+  std::vector<Dune::TypeTree::DynamicTreePath> paths;
+  std::size_t posts = 0;
+};
+
+
 int main()
 {
   Dune::TestSuite test("tree traversal check");
@@ -262,5 +312,225 @@ int main()
       << "Counting all node visitations failed. Result is " << visits << " but should be " << 8;
   }
 
+  {
+    PathCollector<Dune::TypeTree::DynamicTraversal> dynamicCollector;
+    PathCollector<Dune::TypeTree::InPlaceTraversal> inPlaceCollector;
+    applyToTree(tree, dynamicCollector);
+    applyToTree(tree, inPlaceCollector);
+    test.check(inPlaceCollector.paths.size() == 6)
+      << "Counting all nodes with in-place traversal failed. Result is " << inPlaceCollector.paths.size() << " but should be " << 6;
+    test.check(inPlaceCollector.paths == dynamicCollector.paths)
+      << "Tree paths of in-place traversal differ from dynamic traversal";
+  }
+
+  {
+    std::size_t batches = 0;
+    std::size_t batchedLeafs = 0;
+    std::size_t singleLeafs = 0;
+    Dune::TypeTree::forEachLeafBatch(tree,
+      [&](auto&& batch, auto&& path) {
+        ++batches;
+        static_assert(decltype(lanes(batch))::value == 3);
+        for (std::size_t l = 0; l < lanes(batch); ++l) {
+          ++batchedLeafs;
+          test.check(&lane(l, batch) == &Dune::TypeTree::child(tree, push_back(path, l)))
+            << "Leaf in lane " << l << " of batch does not match child of power node";
+        }
+      },
+      [&](auto&& node, auto&& path) {
+        ++singleLeafs;
+      });
+    test.check(batches==1)
+      << "Counting leaf batches with forEachLeafBatch failed. Result is " << batches << " but should be " << 1;
+    test.check(batchedLeafs==3)
+      << "Counting batched leafs with forEachLeafBatch failed. Result is " << batchedLeafs << " but should be " << 3;
+    test.check(singleLeafs==1)
+      << "Counting single leafs with forEachLeafBatch failed. Result is " << singleLeafs << " but should be " << 1;
+  }
+
+  {
+    // nested power nodes are visited by a flat loop in forEachLeafNode
+    auto leaf = leafNode(Payload(0));
+    auto inner = powerNode(Payload(0), leaf, leaf, leaf);
+    auto nestedPower = powerNode(Payload(0), inner, inner);
+
+    std::vector<Dune::TypeTree::DynamicTreePath> leafPaths;
+    std::vector<const void*> leafs;
+    forEachNode(nestedPower, [](auto&&, auto&&) {}, [&](auto&& node, auto&& path) {
+      leafPaths.push_back(path);
+      leafs.push_back(&node);
+    }, [](auto&&, auto&&) {});
+
+    std::size_t k = 0;
+    forEachLeafNode(nestedPower, [&](auto&& node, auto&& path) {
+      static_assert(std::is_same_v<std::decay_t<decltype(path)>, decltype(Dune::TypeTree::hybridTreePath(0,0))>);
+      test.check(k < leafs.size() && leafPaths[k] == path && leafs[k] == &node)
+        << "Leaf " << k << " visited by forEachLeafNode does not match recursive traversal";
+      ++k;
+    });
+    test.check(k==6)
+      << "Counting leaf nodes of nested power node with forEachLeafNode failed. Result is " << k << " but should be " << 6;
+  }
+
+  {
+    // subtrees rejected by a static predicate are not instantiated
+    std::size_t leaf = 0;
+    forEachLeafNode(tree,
+      [](auto&& node, auto&& path) {
+        return std::bool_constant<not std::decay_t<decltype(node)>::isPower>{};
+      },
+      [&](auto&& node, auto&& path) {
+        static_assert(std::decay_t<decltype(path)>::size() == 1);
+        ++leaf;
+      });
+    test.check(leaf==1)
+      << "Counting leaf nodes with static predicate failed. Result is " << leaf << " but should be " << 1;
+  }
+
+  {
+    std::vector<Dune::TypeTree::DynamicTreePath> leafPaths;
+    forEachLeafNode(tree,
+      [](auto&& node, auto&& path) {
+        return path.size() < 2 || path[1] != 1;
+      },
+      [&](auto&& node, auto&& path) {
+        leafPaths.push_back(path);
+      });
+    test.check(leafPaths == std::vector<Dune::TypeTree::DynamicTreePath>{{0,0},{0,2},{1}})
+      << "Leaf nodes visited with dynamic predicate do not match";
+  }
+
+  {
+    // read-only traversal and child extraction do not touch reference counts
+    const auto& constTree = tree;
+    const auto& powerStorage = std::get<0>(constTree.nodeStorage());
+    const auto& leafStorage = constTree.child(Dune::Indices::_0).nodeStorage()[1];
+    auto powerUseCount = powerStorage.use_count();
+    auto leafUseCount = leafStorage.use_count();
+    forEachNode(constTree, [&](auto&& node, auto&& path) {
+      test.check(powerStorage.use_count() == powerUseCount && leafStorage.use_count() == leafUseCount)
+        << "Read-only traversal modified a reference count";
+    });
+
+    auto storage = Dune::TypeTree::childStorage(constTree, Dune::Indices::_0, 1);
+    static_assert(std::is_same_v<decltype(storage), std::shared_ptr<const std::decay_t<decltype(*leafStorage)>>>);
+    test.check(storage == leafStorage)
+      << "childStorage() returned wrong storage object";
+    test.check(powerStorage.use_count() == powerUseCount)
+      << "childStorage() copied the storage of an intermediate node";
+  }
+
+  {
+    // visit the corresponding leafs of several trees at once
+    std::vector<decltype(tree)> trees;
+    for (std::size_t k = 0; k < 4; ++k)
+      trees.push_back(compositeNode(
+        Payload(0),
+        powerNode(Payload(0), leafNode(Payload(k)), leafNode(Payload(k)), leafNode(Payload(k))),
+        leafNode(Payload(k))));
+
+    std::size_t leafPositions = 0;
+    Dune::TypeTree::forEachLeafNodeBatched(std::span(trees), [&](auto&& leafs, auto&& path) {
+      ++leafPositions;
+      test.check(lanes(leafs) == trees.size());
+      for (std::size_t k = 0; k < lanes(leafs); ++k)
+        test.check(&lane(k, leafs) == &Dune::TypeTree::child(trees[k], path) && lane(k, leafs).value() == k)
+          << "Leaf in lane " << k << " does not match leaf of tree " << k;
+    });
+    test.check(leafPositions==4)
+      << "Counting leaf positions with forEachLeafNodeBatched failed. Result is " << leafPositions << " but should be " << 4;
+
+    leafPositions = 0;
+    Dune::TypeTree::forEachLeafNodeBatched(std::span(trees), [&](auto&& leafs, auto&& path) {
+      ++leafPositions;
+      return Dune::TypeTree::TraversalStatus::stop;
+    });
+    test.check(leafPositions==1)
+      << "forEachLeafNodeBatched did not stop. Visited " << leafPositions << " leaf positions but should be " << 1;
+
+    // a span of static extent over const trees
+    leafPositions = 0;
+    std::span<const decltype(tree), 4> constTrees(trees.data(), 4);
+    Dune::TypeTree::forEachLeafNodeBatched(constTrees, [&](auto&& leafs, auto&& path) {
+      ++leafPositions;
+      for (std::size_t k = 0; k < lanes(leafs); ++k)
+        test.check(&lane(k, leafs) == &Dune::TypeTree::child(trees[k], path))
+          << "Leaf in lane " << k << " does not match leaf of const tree " << k;
+    });
+    test.check(leafPositions==4)
+      << "Counting leaf positions of const trees with forEachLeafNodeBatched failed. Result is " << leafPositions << " but should be " << 4;
+  }
+
+  {
+    // callbacks returning TraversalStatus::stop end the traversal
+    using Dune::TypeTree::TraversalStatus;
+    std::vector<Dune::TypeTree::DynamicTreePath> paths;
+    std::size_t posts = 0;
+    forEachNode(tree,
+      [&](auto&& node, auto&& path) { paths.push_back(path); },
+      [&](auto&& node, auto&& path) {
+        paths.push_back(path);
+        return paths.size() == 3 ? TraversalStatus::stop : TraversalStatus::proceed;
+      },
+      [&](auto&& node, auto&& path) { ++posts; });
+    test.check(paths == std::vector<Dune::TypeTree::DynamicTreePath>{{},{0},{0,0}} && posts == 0)
+      << "forEachNode did not stop at the requested leaf";
+
+    std::size_t leafs = 0;
+    forEachNode(tree, [&](auto&& node, auto&& path) {
+      ++leafs;
+      return std::decay_t<decltype(node)>::isPower ? TraversalStatus::stop : TraversalStatus::proceed;
+    });
+    test.check(leafs == 2)
+      << "forEachNode did not stop at the power node. Visited " << leafs << " nodes but should be " << 2;
+
+    // early exit from the flat loop over nested power nodes
+    auto leaf = leafNode(Payload(0));
+    auto inner = powerNode(Payload(0), leaf, leaf, leaf);
+    auto nestedPower = powerNode(Payload(0), inner, inner);
+    Dune::TypeTree::DynamicTreePath lastPath;
+    leafs = 0;
+    forEachLeafNode(nestedPower, [&](auto&& node, auto&& path) {
+      lastPath = path;
+      return ++leafs == 4 ? TraversalStatus::stop : TraversalStatus::proceed;
+    });
+    test.check(leafs == 4 && lastPath == Dune::TypeTree::DynamicTreePath{1,0})
+      << "forEachLeafNode did not stop at the requested leaf of nested power node";
+
+    // early exit from the traversal with predicate
+    leafs = 0;
+    forEachLeafNode(tree,
+      [](auto&& node, auto&& path) { return true; },
+      [&](auto&& node, auto&& path) {
+        ++leafs;
+        return TraversalStatus::stop;
+      });
+    test.check(leafs == 1)
+      << "forEachLeafNode with predicate did not stop. Visited " << leafs << " leafs but should be " << 1;
+
+    // early exit from the batched traversal
+    std::size_t singleLeafs = 0;
+    Dune::TypeTree::forEachLeafBatch(tree,
+      [&](auto&& batch, auto&& path) { return TraversalStatus::stop; },
+      [&](auto&& node, auto&& path) { ++singleLeafs; });
+    test.check(singleLeafs == 0)
+      << "forEachLeafBatch did not stop at the leaf batch";
+
+    auto checkVisitor = [&](auto&& visitor, const char* name) {
+      applyToTree(tree, visitor);
+      test.check(visitor.paths == std::vector<Dune::TypeTree::DynamicTreePath>{{},{0},{0,0},{0,1}} && visitor.posts == 0)
+        << "applyToTree with " << name << " traversal did not stop at the requested leaf";
+    };
+    checkVisitor(StoppingCollector<Dune::TypeTree::StaticTraversal>({0,1}), "static");
+    checkVisitor(StoppingCollector<Dune::TypeTree::DynamicTraversal>({0,1}), "dynamic");
+    checkVisitor(StoppingCollector<Dune::TypeTree::InPlaceTraversal>({0,1}), "in-place");
+
+    // visitors that never stop see the whole tree
+    StoppingCollector<Dune::TypeTree::DynamicTraversal> collector({2});
+    applyToTree(tree, collector);
+    test.check(collector.paths.size() == 6 && collector.posts == 2)
+      << "applyToTree stopped although no callback returned TraversalStatus::stop";
+  }
+
   return test.exit();
 }
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+#include "config.h"
+
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <dune/common/indices.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include "typetreetestutility.hh"
+
+#include <dune/typetree/dynamictreepath.hh>
+#include <dune/typetree/traversal.hh>
+
+int main(int argc, char** argv)
+{
+  using namespace Dune::Indices;
+  using Dune::TypeTree::DynamicTreePath;
+  using Dune::TypeTree::hybridTreePath;
+
+  Dune::TestSuite suite("Check DynamicTreePath");
+
+  {
+    DynamicTreePath root;
+    suite.check(root.empty());
+    suite.check(root.size() == 0);
+    suite.check(root == DynamicTreePath(hybridTreePath()));
+
+    DynamicTreePath tp = hybridTreePath(_1,3,_2,5);
+    suite.check(tp.size() == 4);
+    suite.check(tp.front() == 1);
+    suite.check(tp.back() == 5);
+    suite.check(tp[1] == 3);
+    suite.check(tp[2] == 2);
+    suite.check(tp == DynamicTreePath{1,3,2,5});
+    suite.check(tp != DynamicTreePath{1,3,2});
+
+    tp.pop_back();
+    suite.check(tp == hybridTreePath(1,3,2));
+    tp.push_back(7);
+    suite.check(tp == hybridTreePath(1,3,2,7));
+
+    suite.check(DynamicTreePath{1,2} < DynamicTreePath{1,3});
+    suite.check(DynamicTreePath{1,2} < DynamicTreePath{1,2,0});
+    suite.check(DynamicTreePath{2} > DynamicTreePath{1,5});
+
+    std::stringstream os;
+    os << tp;
+    suite.check(os.str() == "DynamicTreePath< 1 3 2 7 >");
+  }
+
+  { // grow beyond the inline capacity and check copy and move semantics
+    DynamicTreePath tp;
+    for (std::size_t i = 0; i < 3*DynamicTreePath::inlineCapacity; ++i)
+      tp.push_back(i);
+    suite.check(tp.size() == 3*DynamicTreePath::inlineCapacity);
+    suite.check(tp.capacity() >= tp.size());
+    for (std::size_t i = 0; i < tp.size(); ++i)
+      suite.check(tp[i] == i);
+
+    DynamicTreePath copy = tp;
+    suite.check(copy == tp);
+
+    DynamicTreePath moved = std::move(copy);
+    suite.check(moved == tp);
+    suite.check(copy.empty());
+
+    DynamicTreePath small{1,2};
+    small = moved;
+    suite.check(small == tp);
+    small = DynamicTreePath{4,5};
+    suite.check(small == DynamicTreePath{4,5});
+  }
+
+  { // hash is compatible with the one of HybridTreePath
+    auto tp = hybridTreePath(_1,3,_2);
+    suite.check(std::hash<DynamicTreePath>{}(tp) == std::hash<decltype(tp)>{}(tp));
+
+    std::unordered_set<DynamicTreePath> set;
+    set.insert(hybridTreePath(_0));
+    set.insert(hybridTreePath(0));
+    set.insert(hybridTreePath(0,_1));
+    suite.check(set.size() == 2);
+  }
+
+  { // collect the leaf paths of a mixed tree and resolve them
+    using SC = SimpleComposite<SimpleLeaf,SimplePower<SimpleLeaf,3>,SimpleDynamicPower<SimpleLeaf>>;
+    SimpleLeaf leaf;
+    SimplePower<SimpleLeaf,3> power(leaf,leaf,leaf);
+    SimpleDynamicPower<SimpleLeaf> dynamicPower(leaf,leaf);
+    SC tree(leaf,power,dynamicPower);
+
+    std::vector<DynamicTreePath> paths;
+    std::vector<const void*> leafs;
+    Dune::TypeTree::forEachLeafNode(tree, [&](auto&& node, auto tp) {
+      paths.push_back(tp);
+      leafs.push_back(&node);
+    });
+    suite.check(paths.size() == 6);
+    suite.check(paths[0] == DynamicTreePath{0});
+    suite.check(paths[3] == DynamicTreePath{1,2});
+    suite.check(paths[5] == DynamicTreePath{2,1});
+
+    for (std::size_t i = 0; i < paths.size(); ++i)
+      Dune::TypeTree::applyToChild(tree, paths[i], [&](auto&& node) {
+        suite.check(&node == leafs[i])
+          << "applyToChild() did not find the leaf at " << paths[i];
+      });
+
+    std::string name;
+    Dune::TypeTree::applyToChild(tree, DynamicTreePath{1}, [&](auto&& node) {
+      name = node.name();
+    });
+    suite.check(name == "SimplePower");
+  }
+
+  return suite.exit();
+}
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+#include "config.h"
+
+#include <dune/common/test/testsuite.hh>
+
+// generated by dune_typetree_add_instantiations(), declares the instantiations extern
+#include "explicitinstantiations.hh"
+
+int main(int argc, char** argv)
+{
+  Dune::TestSuite suite("Check explicitly instantiated traversals and transformations");
+
+  SimpleLeaf leaf;
+  SimplePower<SimpleLeaf,3> power(leaf,leaf,leaf);
+  SimpleDynamicPower<SimpleLeaf> dynamicPower(leaf,leaf);
+  ExplicitInstantiationTree tree(leaf,power,dynamicPower);
+
+  LeafCounter counter;
+  Dune::TypeTree::applyToTree(tree, counter);
+  suite.check(counter.leafCount == 6)
+    << "visited " << counter.leafCount << " leafs instead of 6";
+
+  const ExplicitInstantiationTree& constTree = tree;
+  Dune::TypeTree::applyToTree(constTree, counter);
+  suite.check(counter.leafCount == 12)
+    << "visited " << counter.leafCount << " leafs instead of 12";
+
+  using Transform = Dune::TypeTree::TransformTree<ExplicitInstantiationTree,TestTransformation>;
+  Transform::transformed_type transformed = Transform::transform(tree, TestTransformation());
+  suite.check(transformed.child(Dune::Indices::_2).degree() == 2)
+    << "transformed dynamic power node has wrong degree";
+  suite.check(transformed.child(Dune::Indices::_1).child(0).id() == leaf.id())
+    << "transformed leaf does not refer to the source leaf";
+
+  return suite.exit();
+}
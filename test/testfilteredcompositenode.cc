@@ -13,12 +13,16 @@ int main()
 
 #else
 
+#include <dune/common/test/testsuite.hh>
+
+#include <dune/typetree/dynamicfilterednode.hh>
 #include <dune/typetree/filteredcompositenode.hh>
 
 #include "typetreetestutility.hh"
 #include "typetreetargetnodes.hh"
 
 #include <type_traits>
+#include <vector>
 
 struct LeafFilter
   : public Dune::TypeTree::SimpleFilter
@@ -80,6 +84,32 @@ void testFilteredCompositeNode(Node& node, Filter filter)
 }
 
 
+template<typename Node>
+void testDynamicFilteredNode(Dune::TestSuite& suite, Node& node)
+{
+  using FN = Dune::TypeTree::DynamicFilteredNode<Node>;
+  static_assert(std::is_same_v<typename FN::NodeTag,Dune::TypeTree::DynamicPowerNodeTag>);
+
+  FN all(node);
+  suite.check(all.degree() == node.degree());
+
+  FN filteredNode(node, {2,0});
+  suite.check(filteredNode.degree() == 2);
+  suite.check(&filteredNode.child(0) == &node.child(2));
+  suite.check(&filteredNode.child(1) == &node.child(0));
+
+  std::vector<const void*> visited;
+  Dune::TypeTree::forEachLeafNode(filteredNode, [&](auto&& leaf, auto treePath) {
+    suite.check(&leaf == &node.child(filteredNode.originalIndex(treePath[0])));
+    visited.push_back(&leaf);
+  });
+  suite.check(visited.size() == 2) << "traversal visited excluded children";
+
+  filteredNode.filter([&](auto&& child, std::size_t i) { return i < 3 and i != 1; });
+  suite.check(filteredNode.indices() == std::vector<std::size_t>{0,2});
+}
+
+
 int main(int argc, char** argv)
 {
 
@@ -126,7 +156,16 @@ int main(int argc, char** argv)
   testFilteredCompositeNode(sfn,IndexFilter1());
   testFilteredCompositeNode<const SFN>(sfn,IndexFilter1());
 
-  return 0;
+  Dune::TestSuite suite("Check DynamicFilteredNode");
+
+  testDynamicFilteredNode(suite,sp1_3);
+  testDynamicFilteredNode<const SP1>(suite,sp1_3);
+
+  typedef SimpleDynamicPower<SimpleLeaf> SDP;
+  SDP sdp{SimpleLeaf(),SimpleLeaf(),SimpleLeaf(),SimpleLeaf()};
+  testDynamicFilteredNode(suite,sdp);
+
+  return suite.exit();
 }
 
 #endif
@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+#include "config.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dune/common/test/testsuite.hh>
+
+#include "typetreetestutility.hh"
+
+#include <dune/typetree/dynamictreepath.hh>
+#include <dune/typetree/fusedvisitor.hh>
+#include <dune/typetree/traversal.hh>
+
+using Dune::TypeTree::DynamicTreePath;
+
+using Event = std::pair<std::string,DynamicTreePath>;
+
+// Records all calls, together with the tree path of the node
+template<class ChildSelection, class Traversal = Dune::TypeTree::DynamicTraversal>
+struct Recorder
+  : public Dune::TypeTree::DefaultVisitor
+  , public ChildSelection
+  , public Traversal
+{
+  explicit Recorder(int id = 0, std::vector<int>* order = nullptr)
+    : id(id), order(order)
+  {}
+
+  template<class T, class TreePath>
+  void pre(T&&, TreePath treePath) { record("pre", treePath); }
+
+  template<class T, class TreePath>
+  void in(T&&, TreePath treePath) { record("in", treePath); }
+
+  template<class T, class TreePath>
+  void post(T&&, TreePath treePath) { record("post", treePath); }
+
+  template<class T, class TreePath>
+  void leaf(T&&, TreePath treePath) { record("leaf", treePath); }
+
+  template<class T, class Child, class TreePath, class ChildIndex>
+  void beforeChild(T&&, Child&&, TreePath treePath, ChildIndex i) { record("beforeChild", push_back(treePath, i)); }
+
+  template<class T, class Child, class TreePath, class ChildIndex>
+  void afterChild(T&&, Child&&, TreePath treePath, ChildIndex i) { record("afterChild", push_back(treePath, i)); }
+
+  template<class TreePath>
+  void record(std::string event, TreePath treePath)
+  {
+    events.emplace_back(event, DynamicTreePath(treePath));
+    if (order)
+      order->push_back(id);
+  }
+
+  int id;
+  std::vector<int>* order;
+  std::vector<Event> events;
+};
+
+// Visits the whole tree except for the subtrees of power nodes
+struct SkipPowerChildren
+{
+  template<class Node, class Child, class TreePath>
+  struct VisitChild
+  {
+    static const bool value = not Child::isPower;
+  };
+};
+
+// Stops the traversal at the second leaf
+struct StopAtSecondLeaf
+  : public Dune::TypeTree::TreeVisitor
+  , public Dune::TypeTree::DynamicTraversal
+{
+  template<class T, class TreePath>
+  Dune::TypeTree::TraversalStatus leaf(T&&, TreePath)
+  {
+    return ++leafs == 2 ? Dune::TypeTree::TraversalStatus::stop : Dune::TypeTree::TraversalStatus::proceed;
+  }
+
+  int leafs = 0;
+};
+
+template<class Tree, class Visitor>
+std::vector<Event> separately(const Tree& tree, Visitor visitor)
+{
+  Dune::TypeTree::applyToTree(tree, visitor);
+  return visitor.events;
+}
+
+int main(int argc, char** argv)
+{
+  Dune::TestSuite suite("Check fuseVisitors");
+
+  using SP = SimplePower<SimpleLeaf,3>;
+  using SDP = SimpleDynamicPower<SP>;
+  using SC = SimpleComposite<SimpleLeaf,SP,SimpleComposite<SimpleLeaf,SDP>>;
+
+  SimpleLeaf leaf;
+  SP power(leaf,leaf,leaf);
+  SC tree(leaf,power,SimpleComposite<SimpleLeaf,SDP>(leaf,SDP(power,power)));
+
+  using WholeTree = Recorder<Dune::TypeTree::VisitTree>;
+  using DirectChildren = Recorder<Dune::TypeTree::VisitDirectChildren>;
+  using NoPowerChildren = Recorder<SkipPowerChildren,Dune::TypeTree::StaticTraversal>;
+
+  {
+    std::vector<int> order;
+    WholeTree whole(0, &order);
+    DirectChildren direct(1, &order);
+    NoPowerChildren noPower(2, &order);
+    auto fused = Dune::TypeTree::fuseVisitors(whole, direct, noPower);
+    static_assert(decltype(fused)::treePathType == Dune::TypeTree::TreePathType::fullyStatic);
+    Dune::TypeTree::applyToTree(tree, fused);
+
+    suite.check(whole.events == separately(tree, WholeTree()))
+      << "fused visitor of the whole tree saw different calls than in a separate traversal";
+    suite.check(direct.events == separately(tree, DirectChildren()))
+      << "fused visitor of the direct children saw different calls than in a separate traversal";
+    suite.check(noPower.events == separately(tree, NoPowerChildren()))
+      << "fused visitor skipping power nodes saw different calls than in a separate traversal";
+    suite.check(order.size() >= 3 and order[0] == 0 and order[1] == 1 and order[2] == 2)
+      << "fused visitors not called in order";
+  }
+
+  {
+    // visitors passed as rvalues are stored in the fused visitor
+    auto fused = Dune::TypeTree::fuseVisitors(WholeTree(), DirectChildren());
+    static_assert(decltype(fused)::treePathType == Dune::TypeTree::TreePathType::dynamic);
+    Dune::TypeTree::applyToTree(tree, fused);
+    suite.check(fused.visitor(Dune::Indices::_1).events == separately(tree, DirectChildren()))
+      << "fused visitor stored by value saw different calls than in a separate traversal";
+  }
+
+  {
+    // stopping one visitor ends the traversal for all of them
+    WholeTree whole;
+    StopAtSecondLeaf stop;
+    Dune::TypeTree::applyToTree(tree, Dune::TypeTree::fuseVisitors(stop, whole));
+    std::size_t leafs = 0;
+    for (const auto& event : whole.events)
+      leafs += (event.first == "leaf");
+    suite.check(stop.leafs == 2 and leafs == 2)
+      << "traversal not stopped by fused visitor";
+  }
+
+  return suite.exit();
+}
@@ -6,6 +6,8 @@
 #include <type_traits>
 #include <cassert>
 #include <sstream>
+#include <map>
+#include <unordered_set>
 
 #include <dune/common/deprecated.hh>
 #include <dune/common/version.hh>
@@ -212,5 +214,42 @@ DUNE_NO_DEPRECATED_END
     suite.check(mi == mi_tuple);
   }
 
+  { // test hashing and ordering of HybridTreePath
+
+    using Dune::TypeTree::hybridTreePath;
+
+    auto hash = [](const auto& tp) { return std::hash<std::decay_t<decltype(tp)>>{}(tp); };
+
+    // equal paths have equal hashes, independent of static or dynamic storage
+    suite.check(hash(hybridTreePath(1,2,3)) == hash(hybridTreePath(_1,2,_3)));
+    suite.check(hash(hybridTreePath(1,2,3)) != hash(hybridTreePath(3,2,1)));
+    suite.check(hash(hybridTreePath(0)) != hash(hybridTreePath(0,0)));
+
+    // the hash of a static path is a compile time constant
+    constexpr std::size_t staticHash = std::hash<decltype(hybridTreePath(_1,_2,_3))>{}(hybridTreePath(_1,_2,_3));
+    suite.check(staticHash == hash(hybridTreePath(1,2,3)));
+
+    static_assert(hybridTreePath(_1,_2) < hybridTreePath(_1,_3));
+    static_assert(hybridTreePath(_1,_2) < hybridTreePath(_1,_2,_0));
+    static_assert(hybridTreePath() < hybridTreePath(_0));
+    suite.check(hybridTreePath(1,2,3) < hybridTreePath(1,3));
+    suite.check(hybridTreePath(2) > hybridTreePath(1,5));
+    suite.check(hybridTreePath(1,_2) <= hybridTreePath(_1,2));
+    suite.check(hybridTreePath(1,_2) >= hybridTreePath(_1,2));
+    suite.check((hybridTreePath(1,_2) <=> hybridTreePath(_1,2)) == 0);
+
+    using Path = decltype(hybridTreePath(_1,std::size_t(0)));
+    std::unordered_set<Path> set;
+    std::map<Path,int> map;
+    for (std::size_t i = 0; i < 4; ++i) {
+      set.insert(hybridTreePath(_1,3-i));
+      map[hybridTreePath(_1,3-i)] = i;
+    }
+    suite.check(set.size() == 4);
+    suite.check(set.count(hybridTreePath(_1,2)) == 1);
+    suite.check(map.begin()->first == hybridTreePath(1,0));
+    suite.check(map.begin()->second == 3);
+  }
+
   return suite.exit();
 }
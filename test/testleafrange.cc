@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+#include "config.h"
+
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+#include <dune/common/test/testsuite.hh>
+
+#include "typetreetestutility.hh"
+
+#include <dune/typetree/dynamicfilterednode.hh>
+#include <dune/typetree/dynamictreepath.hh>
+#include <dune/typetree/leafrange.hh>
+#include <dune/typetree/traversal.hh>
+
+// compare the leaf range with the leafs visited by forEachLeafNode()
+template<class Tree>
+void checkLeafRange(Dune::TestSuite& suite, Tree& tree)
+{
+  std::vector<const void*> leafs;
+  std::vector<Dune::TypeTree::DynamicTreePath> paths;
+  Dune::TypeTree::forEachLeafNode(tree, [&](auto&& leaf, auto treePath) {
+    leafs.push_back(&leaf);
+    paths.push_back(treePath);
+  });
+
+  std::size_t k = 0;
+  auto range = Dune::TypeTree::leaves(tree);
+  for (auto it = range.begin(); it != range.end(); ++it, ++k)
+  {
+    suite.check(k < leafs.size() && &*it == leafs[k] && paths[k] == it.treePath())
+      << "leaf " << k << " of leaf range does not match forEachLeafNode()";
+  }
+  suite.check(k == leafs.size())
+    << "leaf range has " << k << " leafs instead of " << leafs.size();
+}
+
+int main(int argc, char** argv)
+{
+  Dune::TestSuite suite("Check LeafRange");
+
+  using SP = SimplePower<SimpleLeaf,3>;
+  using SPP = SimplePower<SP,2>;
+
+  SimpleLeaf leaf;
+  SP power(SimpleLeaf(),leaf,SimpleLeaf());
+  SPP tree(power,false);
+
+  static_assert(std::forward_iterator<Dune::TypeTree::LeafRange<SPP>::Iterator>);
+  static_assert(std::ranges::forward_range<Dune::TypeTree::LeafRange<SPP>>);
+
+  checkLeafRange(suite, tree);
+  checkLeafRange(suite, std::as_const(tree));
+  checkLeafRange(suite, leaf);
+
+  { // stop early and resume
+    auto range = Dune::TypeTree::leaves(tree);
+    auto it = range.begin();
+    std::size_t k = 0;
+    for (; it != range.end(); ++it, ++k)
+      if (k == 2)
+        break;
+    suite.check(it.treePath() == Dune::TypeTree::hybridTreePath(0,2));
+    ++it;
+    suite.check(it.treePath() == Dune::TypeTree::hybridTreePath(1,0));
+    suite.check(std::ranges::distance(it, range.end()) == 3);
+  }
+
+  { // compose with ranges and interleave two iterations
+    auto ids = Dune::TypeTree::leaves(tree)
+      | std::views::transform([](auto&& leaf) { return leaf.id(); })
+      | std::views::take(4);
+    suite.check(std::ranges::distance(ids) == 4);
+
+    auto reference = Dune::TypeTree::leaves(tree).begin();
+    for (auto&& id : ids)
+      suite.check(id == (reference++)->id());
+  }
+
+  { // inner nodes without children are skipped
+    using FN = Dune::TypeTree::DynamicFilteredNode<SP>;
+    using SDP = SimpleDynamicPower<FN>;
+    SDP filtered(FN(power,{}),FN(power,{2,0}),FN(power,{}),FN(power,{1}),FN(power,{}));
+    checkLeafRange(suite, filtered);
+    suite.check(std::ranges::distance(Dune::TypeTree::leaves(filtered)) == 3);
+
+    SDP empty(FN(power,{}),FN(power,{}));
+    suite.check(Dune::TypeTree::leaves(empty).begin() == std::default_sentinel);
+  }
+
+  return suite.exit();
+}
@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+#include "config.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include <dune/common/test/testsuite.hh>
+
+#include "typetreetestutility.hh"
+
+#include <dune/typetree/dynamicfilterednode.hh>
+#include <dune/typetree/dynamictreepath.hh>
+#include <dune/typetree/leafrangeindex.hh>
+#include <dune/typetree/traversal.hh>
+
+// compare the index with a linear scan over the leafs
+template<class Tree, class LeafSize>
+void checkLeafRangeIndex(Dune::TestSuite& suite, const Tree& tree, const Dune::TypeTree::LeafRangeIndex<Tree>& index, LeafSize leafSize)
+{
+  std::vector<Dune::TypeTree::DynamicTreePath> owners;
+  std::vector<std::size_t> localIndices;
+  std::size_t leafCount = 0;
+  Dune::TypeTree::forEachLeafNode(tree, [&](auto&& leaf, auto treePath) {
+    for (std::size_t i = 0; i < leafSize(leaf); ++i) {
+      owners.push_back(treePath);
+      localIndices.push_back(i);
+    }
+    ++leafCount;
+  });
+
+  suite.check(index.leafCount() == leafCount and index.size() == owners.size())
+    << "index has " << index.leafCount() << " leafs and " << index.size() << " flat indices instead of "
+    << leafCount << " and " << owners.size();
+  suite.check(index.isValid(tree))
+    << "index of unchanged tree is not valid";
+  for (std::size_t k = 0; k < std::min(index.size(), owners.size()); ++k)
+  {
+    auto [leaf, localIndex] = index.position(k);
+    suite.check(index.treePath(leaf) == owners[k] and localIndex == localIndices[k])
+      << "flat index " << k << " is mapped to leaf " << index.treePath(leaf) << " and local index " << localIndex
+      << " instead of " << owners[k] << " and " << localIndices[k];
+  }
+}
+
+int main(int argc, char** argv)
+{
+  Dune::TestSuite suite("Check LeafRangeIndex");
+
+  using SP = SimplePower<SimpleLeaf,3>;
+  using SDP = SimpleDynamicPower<SimpleLeaf>;
+  using SC = SimpleComposite<SimpleLeaf,SP,SDP>;
+
+  SimpleLeaf leaf0, leaf1, leaf2, leaf3, leaf4, leaf5;
+  SP power(leaf1,leaf2,leaf3);
+  SDP dynamicPower(leaf4,leaf5);
+  SC tree(leaf0,power,dynamicPower);
+
+  {
+    // uniform leaf sizes
+    auto leafSize = [](auto&& leaf) { return std::size_t(2); };
+    Dune::TypeTree::LeafRangeIndex index(tree, leafSize);
+    checkLeafRangeIndex(suite, tree, index, leafSize);
+  }
+
+  // varying leaf sizes, including empty leaf ranges
+  std::map<const void*, std::size_t> sizes;
+  std::size_t k = 0;
+  Dune::TypeTree::forEachLeafNode(tree, [&](auto&& leaf, auto treePath) {
+    sizes[&leaf] = k++ % 3;
+  });
+  auto leafSize = [&](auto&& leaf) { return sizes[&leaf]; };
+  Dune::TypeTree::LeafRangeIndex index(tree, leafSize);
+  checkLeafRangeIndex(suite, tree, index, leafSize);
+
+  {
+    // change the degree of the dynamic power node and update the index
+    SimpleLeaf newLeaf;
+    sizes[&newLeaf] = 4;
+    tree.setChild(SDP(newLeaf,newLeaf,newLeaf), Dune::Indices::_2);
+    suite.check(not index.isValid(tree))
+      << "index is valid after the degree of a dynamic power node has changed";
+
+    index.update(tree, {2}, leafSize);
+    checkLeafRangeIndex(suite, tree, index, leafSize);
+  }
+
+  {
+    // the degree of a filtered node changes with its selection
+    using Filtered = Dune::TypeTree::DynamicFilteredNode<SP>;
+    using FilteredComposite = SimpleComposite<SP,Filtered>;
+    FilteredComposite filteredTree(power, Filtered(power));
+
+    Dune::TypeTree::LeafRangeIndex filteredIndex(filteredTree, leafSize);
+    checkLeafRangeIndex(suite, filteredTree, filteredIndex, leafSize);
+
+    filteredTree.child(Dune::Indices::_1).setIndices({2,0});
+    suite.check(not filteredIndex.isValid(filteredTree))
+      << "index is valid after the selection of a filtered node has changed";
+    filteredIndex.update(filteredTree, {1}, leafSize);
+    checkLeafRangeIndex(suite, filteredTree, filteredIndex, leafSize);
+
+    filteredTree.child(Dune::Indices::_1).setIndices({});
+    filteredIndex.update(filteredTree, {1}, leafSize);
+    checkLeafRangeIndex(suite, filteredTree, filteredIndex, leafSize);
+
+    filteredTree.child(Dune::Indices::_1).setIndices({1});
+    filteredIndex.rebuild(filteredTree, leafSize);
+    checkLeafRangeIndex(suite, filteredTree, filteredIndex, leafSize);
+  }
+
+  return suite.exit();
+}
@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+#include "config.h"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include <unistd.h>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include "typetreetestutility.hh"
+
+#include <dune/typetree/exceptions.hh>
+#include <dune/typetree/mappedtreecontainer.hh>
+#include <dune/typetree/serialization.hh>
+#include <dune/typetree/traversal.hh>
+#include <dune/typetree/treecontainer.hh>
+
+template<class Tree, class Container>
+void writeFile(const std::string& fileName, const Tree& tree, const Container& container)
+{
+  std::ofstream out(fileName, std::ios::binary);
+  Dune::TypeTree::writeTreeContainer(out, tree, container);
+}
+
+int main(int argc, char** argv)
+{
+  Dune::TestSuite suite("Check memory-mapped tree containers");
+
+  using SP = SimplePower<SimpleLeaf,3>;
+  using SDP = SimpleDynamicPower<SimpleLeaf>;
+  using SC = SimpleComposite<SimpleLeaf,SP,SDP>;
+
+  SimpleLeaf leaf;
+  SP power(leaf,leaf,leaf);
+  SDP dynamicPower(leaf,leaf);
+  SC tree(leaf,power,dynamicPower);
+
+  const std::string fileName = (std::filesystem::temp_directory_path() / ("testmappedtreecontainer-" + std::to_string(::getpid()))).string();
+
+  {
+    // map the values written from a flat container
+    auto container = Dune::TypeTree::makeFlatTreeContainer<double>(tree);
+    std::size_t k = 0;
+    Dune::TypeTree::forEachLeafNode(tree, [&](auto&& node, auto treePath) {
+      container[treePath] = 0.5 * k++;
+    });
+    writeFile(fileName, tree, container);
+
+    auto mapped = Dune::TypeTree::makeMappedTreeContainer<double>(fileName, tree);
+    static_assert(std::is_same_v<decltype(mapped), Dune::TypeTree::MappedTreeContainer<double,SC>>);
+    suite.check(mapped.size() == container.size())
+      << "Mapped tree container has " << mapped.size() << " values instead of " << container.size();
+    Dune::TypeTree::forEachLeafNode(tree, [&](auto&& node, auto treePath) {
+      suite.check(mapped[treePath] == container[treePath])
+        << "Mapped value of leaf " << treePath << " does not match written value";
+    });
+
+    // the mapping is moved along with the container
+    auto moved = std::move(mapped);
+    suite.check(std::equal(moved.values().begin(), moved.values().end(), container.values().begin(), container.values().end()))
+      << "Values of moved mapped tree container do not match written values";
+
+    // self-move assignment keeps the mapping
+    auto& self = moved;
+    moved = std::move(self);
+    suite.check(std::equal(moved.values().begin(), moved.values().end(), container.values().begin(), container.values().end()))
+      << "Values of self-move-assigned mapped tree container do not match written values";
+  }
+
+  {
+    // the payload of a nested container has the same layout
+    auto container = Dune::TypeTree::makeTreeContainer<std::array<int,2>>(tree);
+    int k = 0;
+    Dune::TypeTree::forEachLeafNode(tree, [&](auto&& node, auto treePath) {
+      container[treePath] = {k, -k};
+      ++k;
+    });
+    writeFile(fileName, tree, container);
+
+    auto mapped = Dune::TypeTree::makeMappedTreeContainer<std::array<int,2>>(fileName, tree);
+    Dune::TypeTree::forEachLeafNode(tree, [&](auto&& node, auto treePath) {
+      suite.check(mapped[treePath] == container[treePath])
+        << "Mapped value of leaf " << treePath << " does not match written value";
+    });
+
+    suite.checkThrow<Dune::TypeTree::Exception>([&]{
+      Dune::TypeTree::makeMappedTreeContainer<float>(fileName, tree);
+    }) << "mapping a file with different value size did not fail";
+
+    SDP otherDynamicPower(leaf,leaf,leaf);
+    SC otherTree(leaf,power,otherDynamicPower);
+    suite.checkThrow<Dune::TypeTree::Exception>([&]{
+      Dune::TypeTree::makeMappedTreeContainer<std::array<int,2>>(fileName, otherTree);
+    }) << "mapping a file written for a tree of different shape did not fail";
+
+    std::filesystem::resize_file(fileName, std::filesystem::file_size(fileName) - 1);
+    suite.checkThrow<Dune::IOError>([&]{
+      Dune::TypeTree::makeMappedTreeContainer<std::array<int,2>>(fileName, tree);
+    }) << "mapping a truncated file did not fail";
+  }
+
+  std::filesystem::remove(fileName);
+  suite.checkThrow<Dune::IOError>([&]{
+    Dune::TypeTree::makeMappedTreeContainer<double>(fileName, tree);
+  }) << "mapping a missing file did not fail";
+
+  return suite.exit();
+}
@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+#include "config.h"
+
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include <dune/common/indices.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include "typetreetestutility.hh"
+
+#include <dune/typetree/nodemap.hh>
+#include <dune/typetree/traversal.hh>
+#include <dune/typetree/treepath.hh>
+
+using namespace Dune::Indices;
+using Dune::TypeTree::treePath;
+using Dune::TypeTree::nodeId;
+using Dune::TypeTree::nodeCount;
+
+using SP = SimplePower<SimpleLeaf,3>;
+using SDP = SimpleDynamicPower<SimpleLeaf>;
+using SC = SimpleComposite<SimpleLeaf,SP,SimplePower<SP,2>>;
+
+// ids of trees of static shape are known at compile time
+static_assert(nodeCount<SimpleLeaf>() == 1);
+static_assert(nodeCount<SP>() == 4);
+static_assert(nodeCount<SC>() == 1 + 1 + 4 + 9);
+static_assert(nodeId<SC>(treePath()) == 0);
+static_assert(nodeId<SC>(treePath(_0)) == 1);
+static_assert(nodeId<SC>(treePath(_1)) == 2);
+static_assert(nodeId<SC>(treePath(_1,_2)) == 5);
+static_assert(nodeId<SC>(treePath(_2)) == 6);
+static_assert(nodeId<SC>(treePath(_2,_1)) == 11);
+static_assert(nodeId<SC>(treePath(_2,_1,_2)) == 14);
+static_assert(Dune::TypeTree::NodeIds<SC>{}.size() == 15);
+static_assert(Dune::TypeTree::NodeIds<SC>{}[treePath(_2,1,0)] == 12);
+static_assert(not Dune::TypeTree::NodeIds<SimpleComposite<SimpleLeaf,SDP>>::isStatic);
+
+// The ids are the positions of the nodes in the order of forEachNode()
+template<class Tree, class Ids>
+bool idsFollowTraversal(const Tree& tree, const Ids& ids)
+{
+  std::size_t count = 0;
+  bool ok = true;
+  Dune::TypeTree::forEachNode(tree, [&](auto&& node, auto tp) {
+    ok = ok and (ids[tp] == count++);
+  });
+  return ok and count == ids.size();
+}
+
+int main(int argc, char** argv)
+{
+  Dune::TestSuite suite("Check NodeIds and NodeMap");
+
+  SimpleLeaf leaf;
+  SP power(leaf,leaf,leaf);
+
+  {
+    SC tree(leaf,power,SimplePower<SP,2>(power,power));
+    suite.check(idsFollowTraversal(tree, Dune::TypeTree::NodeIds<SC>(tree)))
+      << "static ids do not follow the order of forEachNode()";
+
+    auto map = Dune::TypeTree::makeNodeMap<int>(tree, -1);
+    suite.check(map.size() == 15) << "wrong size of static node map";
+    map[treePath(_2,1)] = 3;
+    map[treePath(_2,_1,_0)] = 4;
+    suite.check(map.values()[11] == 3 and map.values()[12] == 4)
+      << "value of static node map stored at wrong position";
+    suite.check(std::accumulate(map.values().begin(), map.values().end(), 0) == 7 - 13)
+      << "values of static node map not initialized";
+  }
+
+  {
+    using Tree = SimpleComposite<SimpleLeaf,SimpleDynamicPower<SP>,SDP,SP>;
+    Tree tree(leaf, SimpleDynamicPower<SP>(power,power), SDP(leaf,leaf,leaf), power);
+
+    Dune::TypeTree::NodeIds<Tree> ids(tree);
+    suite.check(ids.size() == 1 + 1 + 9 + 4 + 4) << "wrong number of dynamic ids";
+    suite.check(idsFollowTraversal(tree, ids))
+      << "dynamic ids do not follow the order of forEachNode()";
+    suite.check(ids[treePath(_1,1,2)] == 10) << "wrong id in static subtree of dynamic node";
+    suite.check(ids[treePath(_3,2)] == 18) << "wrong id behind dynamic node";
+
+    auto map = Dune::TypeTree::makeNodeMap<double>(tree);
+    map[treePath(_2)] = 1.5;
+    suite.check(map[treePath(_2)] == 1.5 and map.values()[ids[treePath(_2)]] == 1.5)
+      << "dynamic node map returns wrong value";
+
+    // change the degree of the dynamic power nodes
+    tree.setChild(SimpleDynamicPower<SP>(power,power,power), _1);
+    tree.setChild(SDP(leaf,leaf), _2);
+    map.update(tree, 2.0);
+    suite.check(map.size() == 1 + 1 + 13 + 3 + 4) << "node map not updated";
+    suite.check(idsFollowTraversal(tree, map.ids()))
+      << "updated ids do not follow the order of forEachNode()";
+    suite.check(map[treePath(_2)] == 2.0) << "values of updated node map not reset";
+  }
+
+  {
+    // nested dynamic nodes of different degrees
+    using Nested = SimpleDynamicPower<SDP>;
+    Nested tree(SDP(leaf,leaf,leaf),SDP(leaf,leaf));
+    suite.check(idsFollowTraversal(tree, Dune::TypeTree::NodeIds<Nested>(tree)))
+      << "ids of nested dynamic nodes do not follow the order of forEachNode()";
+  }
+
+  return suite.exit();
+}
@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+#include "config.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+
+#include <dune/common/test/testsuite.hh>
+
+#include "typetreetestutility.hh"
+
+#include <dune/typetree/dynamictreepath.hh>
+#include <dune/typetree/paralleltraversal.hh>
+#include <dune/typetree/traversalutilities.hh>
+
+using Dune::TypeTree::DynamicTreePath;
+
+// Records the visited leafs and checks that afterChild() and post() are
+// only called once the subtree below the respective node is complete.
+struct OrderChecker
+  : public Dune::TypeTree::TreeVisitor
+  , public Dune::TypeTree::DynamicTraversal
+{
+  template<class Node, class TreePath>
+  void leaf(Node&& node, TreePath treePath)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    leafs.insert(treePath);
+  }
+
+  template<class Node, class Child, class TreePath, class ChildIndex>
+  void afterChild(Node&& node, Child&& child, TreePath treePath, ChildIndex i)
+  {
+    check(child, push_back(treePath, i));
+  }
+
+  template<class Node, class TreePath>
+  void post(Node&& node, TreePath treePath)
+  {
+    check(node, treePath);
+  }
+
+  // check that all leafs below treePath have been visited
+  template<class Node>
+  void check(Node&& node, DynamicTreePath treePath)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t visited = std::count_if(leafs.begin(), leafs.end(), [&](const DynamicTreePath& tp) {
+      return tp.size() >= treePath.size() and std::equal(treePath.begin(), treePath.end(), tp.begin());
+    });
+    if (visited != std::size_t(Dune::TypeTree::Experimental::Info::leafCount(node)))
+      ++incomplete;
+  }
+
+  std::mutex mutex;
+  std::set<DynamicTreePath> leafs;
+  std::size_t incomplete = 0;
+};
+
+struct ThrowingVisitor
+  : public Dune::TypeTree::TreeVisitor
+  , public Dune::TypeTree::DynamicTraversal
+{
+  template<class Node, class TreePath>
+  void leaf(Node&& node, TreePath treePath) const
+  {
+    if (treePath.size() == 3)
+      throw std::runtime_error("leaf visit failed");
+  }
+};
+
+struct ValueLeaf
+  : public Dune::TypeTree::LeafNode
+{
+  explicit ValueLeaf(double v)
+    : value(v)
+  {}
+
+  double value;
+};
+
+using ValuePower = SimplePower<ValueLeaf,3>;
+
+struct LargeDynamicPower
+  : public Dune::TypeTree::DynamicPowerNode<ValuePower>
+{
+  explicit LargeDynamicPower(NodeStorage children)
+    : Dune::TypeTree::DynamicPowerNode<ValuePower>(std::move(children))
+  {}
+};
+
+using ValueTree = SimpleComposite<ValueLeaf,ValuePower,LargeDynamicPower>;
+
+// values of very different magnitude, such that the sum depends on the order of the summation
+ValueTree makeValueTree(std::size_t degree)
+{
+  std::size_t k = 0;
+  auto value = [&] {
+    return ++k == 1 ? 1e16 : 1.0;
+  };
+  auto power = [&] {
+    return std::make_shared<ValuePower>(ValueLeaf(value()), ValueLeaf(value()), ValueLeaf(value()));
+  };
+  LargeDynamicPower::NodeStorage children;
+  for (std::size_t i = 0; i < degree; ++i)
+    children.push_back(power());
+  return ValueTree(ValueLeaf(value()), ValuePower(*power()), LargeDynamicPower(std::move(children)));
+}
+
+int main(int argc, char** argv)
+{
+  Dune::TestSuite suite("Check parallel tree traversal");
+
+  using SP = SimplePower<SimpleLeaf,3>;
+  using SDP = SimpleDynamicPower<SP>;
+  using SC = SimpleComposite<SimpleLeaf,SP,SDP>;
+
+  SimpleLeaf leaf;
+  SP power(leaf,leaf,leaf);
+  SDP dynamicPower(power,power,power,power,power,power,power,power);
+  SC tree(leaf,power,dynamicPower);
+
+  {
+    // the precomputed subtree sizes agree with the leaf counts of all nodes
+    Dune::TypeTree::Detail::SubtreeSizes sizes(tree);
+    std::size_t id = 0;
+    Dune::TypeTree::forEachNode(tree, [&](auto&& node, auto treePath) {
+      suite.check(sizes.leafs(node, id) == std::size_t(Dune::TypeTree::Experimental::Info::leafCount(node)))
+        << "Wrong number of leafs for subtree " << treePath;
+      if constexpr (Dune::TypeTree::Detail::SubtreeSizes::isStored<std::decay_t<decltype(node)>>)
+        ++id;
+    });
+
+    // subtrees without nodes of run time degree are not stored
+    Dune::TypeTree::Detail::SubtreeSizes staticSizes(power);
+    suite.check(staticSizes.leafs(power, 0) == 3)
+      << "Wrong number of leafs for static tree";
+  }
+
+  OrderChecker sequential;
+  Dune::TypeTree::applyToTree(tree, sequential);
+
+  for (std::size_t workers : {0, 1, 4})
+  {
+    Dune::TypeTree::TraversalThreadPool pool(workers);
+    for (std::size_t grainSize : {1, 3, 100})
+    {
+      OrderChecker parallel;
+      Dune::TypeTree::applyToTree(tree, parallel, pool, grainSize);
+      suite.check(parallel.leafs == sequential.leafs)
+        << "parallel traversal with " << workers << " workers and grain size " << grainSize
+        << " visited different leafs than sequential traversal";
+      suite.check(parallel.incomplete == 0)
+        << "parallel traversal with " << workers << " workers and grain size " << grainSize
+        << " called afterChild() or post() before the subtree was complete";
+    }
+
+    {
+      ValueTree valueTree = makeValueTree(100);
+      auto value = [](const ValueLeaf& leaf, auto treePath) { return leaf.value; };
+      auto one = [](const ValueLeaf& leaf, auto treePath) { return 1; };
+
+      Dune::TypeTree::TraversalThreadPool serialPool(0);
+      double reference = Dune::TypeTree::reduceOverLeafs(valueTree, value, std::plus<>(), 0.0, serialPool, 1000);
+      for (std::size_t grainSize : {1, 3, 100})
+      {
+        int count = Dune::TypeTree::reduceOverLeafs(valueTree, one, std::plus<>(), 0, pool, grainSize);
+        suite.check(count == Dune::TypeTree::reduceOverLeafs(valueTree, one, std::plus<>(), 0))
+          << "parallel reduction with " << workers << " workers and grain size " << grainSize
+          << " differs from sequential reduction";
+
+        double sum = Dune::TypeTree::reduceOverLeafs(valueTree, value, std::plus<>(), 0.0, pool, grainSize);
+        suite.check(std::memcmp(&sum, &reference, sizeof(double)) == 0)
+          << "parallel reduction with " << workers << " workers and grain size " << grainSize
+          << " is not bitwise reproducible";
+      }
+    }
+
+    suite.checkThrow<std::runtime_error>([&]{
+      Dune::TypeTree::applyToTree(tree, ThrowingVisitor{}, pool);
+    }) << "exception thrown by visitor was not propagated";
+  }
+
+  return suite.exit();
+}
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
 #include "config.h"
 
+#include <memory>
+
 #include <dune/common/classname.hh>
 #include <dune/common/test/testsuite.hh>
 
@@ -28,10 +30,16 @@ public:
     return this->proxiedNode().id();
   }
 
+  using BaseT::proxiedNodeStorage;
+
   SimpleProxy(Node& node)
     : BaseT(node)
   {}
 
+  SimpleProxy(std::shared_ptr<Node> node)
+    : BaseT(std::move(node))
+  {}
+
 };
 
 template<typename Node>
@@ -45,6 +53,25 @@ void testProxyNode(Node& node)
   static_assert(decltype(Info::depth(node)){} == decltype(Info::depth(proxyNode)){}, "Proxy node has wrong depth");
   suite.check(Info::nodeCount(node) == Info::nodeCount(proxyNode)) << "Proxy node has wrong node count";
   suite.check(Info::leafCount(node) == Info::leafCount(proxyNode)) << "Proxy node has wrong leaf count";
+  suite.check(proxyNode.proxiedNodeStorage().get() == &node) << "Proxy node storage does not refer to proxied node";
+}
+
+void testProxyNodeOwnership()
+{
+  Dune::TestSuite suite{"Check ProxyNode ownership"};
+  auto node = std::make_shared<SimpleLeaf>();
+  {
+    // a proxy constructed from a reference does not touch the reference count
+    SimpleProxy<SimpleLeaf> proxyNode(*node);
+    SimpleProxy<SimpleLeaf> copy = proxyNode;
+    suite.check(node.use_count() == 1) << "Non-owning proxy node changed the reference count";
+    suite.check(copy.id() == node->id());
+  }
+  SimpleProxy<SimpleLeaf> proxyNode(node);
+  suite.check(node.use_count() == 2) << "Owning proxy node does not share the proxied node";
+  auto id = node->id();
+  node.reset();
+  suite.check(proxyNode.id() == id) << "Owning proxy node did not keep the proxied node alive";
 }
 
 
@@ -99,5 +126,7 @@ int main(int argc, char** argv)
   testProxyNode(svc2_1);
   testProxyNode<const SVC2>(svc2_1);
 
+  testProxyNodeOwnership();
+
   return 0;
 }
@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+#include "config.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include "typetreetestutility.hh"
+
+#include <dune/typetree/exceptions.hh>
+#include <dune/typetree/serialization.hh>
+#include <dune/typetree/traversal.hh>
+#include <dune/typetree/treecontainer.hh>
+
+// write a container with distinct values for all leafs and read it into a fresh one
+template<class Tree, class Container, class LeafToValue>
+void checkRoundTrip(Dune::TestSuite& suite, const Tree& tree, Container container, LeafToValue leafToValue, std::string name)
+{
+  std::size_t k = 0;
+  Dune::TypeTree::forEachLeafNode(tree, [&](auto&& leaf, auto treePath) {
+    container[treePath] = leafToValue(k++);
+  });
+
+  std::stringstream stream;
+  Dune::TypeTree::writeTreeContainer(stream, tree, container);
+
+  Container restored = container;
+  Dune::TypeTree::forEachLeafNode(tree, [&](auto&& leaf, auto treePath) {
+    restored[treePath] = {};
+  });
+  Dune::TypeTree::readTreeContainer(stream, tree, restored);
+
+  Dune::TypeTree::forEachLeafNode(tree, [&](auto&& leaf, auto treePath) {
+    suite.check(restored[treePath] == container[treePath])
+      << "Value of leaf " << treePath << " of " << name << " was not restored";
+  });
+}
+
+int main(int argc, char** argv)
+{
+  Dune::TestSuite suite("Check serialization of tree containers");
+
+  using SP = SimplePower<SimpleLeaf,3>;
+  using SDP = SimpleDynamicPower<SimpleLeaf>;
+  using SC = SimpleComposite<SimpleLeaf,SP,SDP>;
+
+  SimpleLeaf leaf;
+  SP power(leaf,leaf,leaf);
+  SDP dynamicPower(leaf,leaf);
+  SC tree(leaf,power,dynamicPower);
+
+  auto toDouble = [](std::size_t k) { return 0.5 * k; };
+  auto toArray = [](std::size_t k) { return std::array<int,3>{int(k), int(k+1), int(k+2)}; };
+  auto toVector = [](std::size_t k) { return std::vector<double>(k, 1.0 * k); };
+
+  checkRoundTrip(suite, tree, Dune::TypeTree::makeTreeContainer<double>(tree), toDouble, "tree container of doubles");
+  checkRoundTrip(suite, tree, Dune::TypeTree::makeTreeContainer<std::array<int,3>>(tree), toArray, "tree container of arrays");
+  checkRoundTrip(suite, tree, Dune::TypeTree::makeTreeContainer<std::vector<double>>(tree), toVector, "tree container of vectors");
+  checkRoundTrip(suite, tree, Dune::TypeTree::makeFlatTreeContainer<double>(tree), toDouble, "flat tree container of doubles");
+  checkRoundTrip(suite, tree, Dune::TypeTree::makeFlatTreeContainer<std::vector<double>>(tree), toVector, "flat tree container of vectors");
+
+  std::stringstream stream;
+  Dune::TypeTree::writeTreeContainer(stream, tree, Dune::TypeTree::makeTreeContainer<double>(tree));
+  const std::string data = stream.str();
+
+  {
+    // the shape of the tree is validated before reading any value
+    SDP otherDynamicPower(leaf,leaf,leaf);
+    SC otherTree(leaf,power,otherDynamicPower);
+    auto container = Dune::TypeTree::makeTreeContainer<double>(otherTree);
+    std::stringstream in(data);
+    suite.checkThrow<Dune::TypeTree::Exception>([&]{
+      Dune::TypeTree::readTreeContainer(in, otherTree, container);
+    }) << "reading a container for a tree of different shape did not fail";
+  }
+
+  {
+    // as well as the types of the values
+    auto container = Dune::TypeTree::makeTreeContainer<float>(tree);
+    std::stringstream in(data);
+    suite.checkThrow<Dune::TypeTree::Exception>([&]{
+      Dune::TypeTree::readTreeContainer(in, tree, container);
+    }) << "reading a container with different value type did not fail";
+  }
+
+  {
+    auto container = Dune::TypeTree::makeTreeContainer<double>(tree);
+    std::stringstream in("no tree container");
+    suite.checkThrow<Dune::TypeTree::Exception>([&]{
+      Dune::TypeTree::readTreeContainer(in, tree, container);
+    }) << "reading a stream with invalid signature did not fail";
+  }
+
+  {
+    auto container = Dune::TypeTree::makeTreeContainer<double>(tree);
+    std::stringstream in(data.substr(0, data.size()-1));
+    suite.checkThrow<Dune::IOError>([&]{
+      Dune::TypeTree::readTreeContainer(in, tree, container);
+    }) << "reading a truncated stream did not fail";
+  }
+
+  {
+    // the length of a stored range is checked before allocating memory for it
+    auto container = Dune::TypeTree::makeTreeContainer<std::vector<double>>(tree);
+    std::size_t valueBytes = 0;
+    std::size_t k = 0;
+    Dune::TypeTree::forEachLeafNode(tree, [&](auto&& leaf, auto treePath) {
+      container[treePath] = toVector(k++);
+      valueBytes += sizeof(std::uint64_t) + container[treePath].size() * sizeof(double);
+    });
+    std::stringstream out;
+    Dune::TypeTree::writeTreeContainer(out, tree, container);
+    std::string corrupted = out.str();
+
+    const std::uint64_t length = std::uint64_t(1) << 60;
+    std::memcpy(corrupted.data() + corrupted.size() - valueBytes, &length, sizeof(length));
+    std::stringstream in(corrupted);
+    suite.checkThrow<Dune::TypeTree::Exception>([&]{
+      Dune::TypeTree::readTreeContainer(in, tree, container);
+    }) << "reading a stream with corrupted range length did not fail";
+  }
+
+  return suite.exit();
+}
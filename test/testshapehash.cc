@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+#include "config.h"
+
+#include <cstdint>
+
+#include <dune/common/test/testsuite.hh>
+
+#include "typetreetestutility.hh"
+
+#include <dune/typetree/shapehash.hh>
+
+using Dune::TypeTree::treeShapeHash;
+
+using SP = SimplePower<SimpleLeaf,3>;
+using SDP = SimpleDynamicPower<SimpleLeaf>;
+using SC = SimpleComposite<SimpleLeaf,SP,SDP>;
+
+// the hash is available at compile time and depends on the shape only
+static_assert(treeShapeHash<SP>() == treeShapeHash<SimplePower<SimpleLeafDerived,3>>());
+static_assert(treeShapeHash<SP>() != treeShapeHash<SimplePower<SimpleLeaf,2>>());
+static_assert(treeShapeHash<SP>() != treeShapeHash<SimpleComposite<SimpleLeaf,SimpleLeaf,SimpleLeaf>>());
+static_assert(treeShapeHash<SimpleLeaf>() != treeShapeHash<SimplePower<SimpleLeaf,1>>());
+static_assert(treeShapeHash<SimpleComposite<SP,SimpleLeaf>>() != treeShapeHash<SimpleComposite<SimpleLeaf,SP>>());
+static_assert(treeShapeHash<SDP>() != treeShapeHash<SimpleDynamicPower<SP>>());
+static_assert(treeShapeHash<const SC&>() == treeShapeHash<SC>());
+
+int main(int argc, char** argv)
+{
+  Dune::TestSuite suite("Check treeShapeHash");
+
+  SimpleLeaf leaf;
+  SP power(leaf,leaf,leaf);
+
+  suite.check(treeShapeHash(power) == treeShapeHash<SP>())
+    << "run time hash of a tree without dynamic nodes differs from compile time hash";
+  suite.check(treeShapeHash(SimpleComposite<SimpleLeaf,SP>(leaf,power)) == treeShapeHash<SimpleComposite<SimpleLeaf,SP>>())
+    << "run time hash of a composite tree without dynamic nodes differs from compile time hash";
+
+  SC tree(leaf,power,SDP(leaf,leaf));
+  SC sameShape(leaf,power,SDP(leaf,leaf));
+  SC otherShape(leaf,power,SDP(leaf,leaf,leaf));
+  const std::uint64_t hash = treeShapeHash(tree);
+
+  suite.check(hash == treeShapeHash(sameShape))
+    << "trees of the same shape have different hashes";
+  suite.check(hash != treeShapeHash(otherShape))
+    << "hash does not depend on the degree of a dynamic power node";
+  suite.check(hash != treeShapeHash<SC>())
+    << "run time hash does not include the degree of a dynamic power node";
+
+  tree.setChild(SDP(leaf,leaf,leaf), Dune::Indices::_2);
+  suite.check(treeShapeHash(tree) == treeShapeHash(otherShape))
+    << "hash does not follow a change of the degree of a dynamic power node";
+
+  {
+    // the shape of the children of a dynamic power node enters the hash
+    using Nested = SimpleDynamicPower<SDP>;
+    Nested nested(SDP(leaf,leaf),SDP(leaf,leaf,leaf));
+    Nested reordered(SDP(leaf,leaf,leaf),SDP(leaf,leaf));
+    suite.check(treeShapeHash(nested) != treeShapeHash(reordered))
+      << "hash does not depend on the degrees of the children of a dynamic power node";
+  }
+
+  return suite.exit();
+}
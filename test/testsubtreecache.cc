@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightInfo: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
+#include "config.h"
+
+#include <functional>
+
+#include <dune/common/indices.hh>
+#include <dune/common/test/testsuite.hh>
+
+#include "typetreetestutility.hh"
+
+#include <dune/typetree/leafnode.hh>
+#include <dune/typetree/subtreecache.hh>
+#include <dune/typetree/traversalutilities.hh>
+#include <dune/typetree/treepath.hh>
+
+using namespace Dune::Indices;
+using Dune::TypeTree::treePath;
+
+struct ValueLeaf
+  : public Dune::TypeTree::LeafNode
+{
+  explicit ValueLeaf(int v)
+    : value(v)
+  {}
+
+  int value;
+};
+
+using P = SimplePower<ValueLeaf,3>;
+using DP = SimpleDynamicPower<ValueLeaf>;
+using Tree = SimpleComposite<ValueLeaf,P,DP>;
+
+int main(int argc, char** argv)
+{
+  Dune::TestSuite suite("Check SubtreeCache");
+
+  Tree tree(ValueLeaf(1), P(ValueLeaf(2),ValueLeaf(3),ValueLeaf(4)), DP(ValueLeaf(5),ValueLeaf(6)));
+
+  int calls = 0;
+  auto functor = [&](const ValueLeaf& leaf, auto treePath) {
+    ++calls;
+    return leaf.value;
+  };
+  auto reference = [&] {
+    return Dune::TypeTree::reduceOverLeafs(tree, [](const ValueLeaf& leaf, auto) { return leaf.value; }, std::plus<>(), 0);
+  };
+
+  auto cache = Dune::TypeTree::makeSubtreeCache(tree, functor, std::plus<>(), 0);
+
+  suite.check(cache.result(tree) == reference()) << "wrong result of the whole tree";
+  suite.check(calls == 6) << "functor called " << calls << " times for 6 leafs";
+
+  calls = 0;
+  suite.check(cache.result(tree) == 21) << "wrong cached result";
+  suite.check(cache.result(tree, treePath(_1)) == 9) << "wrong cached result of power node";
+  suite.check(cache.result(tree, treePath(_2,1)) == 6) << "wrong cached result of leaf";
+  suite.check(calls == 0) << "cached results recomputed";
+
+  // change the data of a leaf
+  Dune::TypeTree::child(tree, _1, 2).value = 10;
+  cache.invalidate(tree, treePath(_1,2));
+  suite.check(cache.result(tree) == reference()) << "wrong result after invalidate()";
+  suite.check(calls == 1) << "unchanged leafs recomputed after invalidate()";
+
+  // invalidate a whole subtree
+  calls = 0;
+  cache.invalidate(tree, treePath(_1));
+  suite.check(cache.result(tree) == reference()) << "wrong result after invalidating a subtree";
+  suite.check(calls == 3) << "invalidate() of a subtree does not reach its leafs";
+
+  // replace children of static shape, addressed by static and dynamic indices
+  calls = 0;
+  cache.setChild(tree, treePath(_0), ValueLeaf(7));
+  cache.setChild(tree, treePath(_1,0), ValueLeaf(8));
+  cache.setChild(tree, treePath(_2,1), ValueLeaf(9));
+  suite.check(cache.result(tree) == reference()) << "wrong result after setChild()";
+  suite.check(calls == 3) << "unchanged leafs recomputed after setChild()";
+
+  // replace a child of dynamic shape by one of a different degree
+  calls = 0;
+  cache.setChild(tree, treePath(_2), DP(ValueLeaf(11),ValueLeaf(12),ValueLeaf(13)));
+  suite.check(cache.result(tree) == reference()) << "wrong result after setChild() of dynamic node";
+  suite.check(calls == 3) << "unchanged subtrees recomputed after setChild() of dynamic node";
+  suite.check(cache.result(tree, treePath(_2)) == 36) << "wrong result of replaced dynamic node";
+
+  calls = 0;
+  cache.update(tree);
+  suite.check(cache.result(tree) == reference()) << "wrong result after update()";
+  suite.check(calls == 7) << "update() does not discard all results";
+
+  return suite.exit();
+}
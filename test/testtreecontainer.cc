@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later OR LicenseRef-GPL-2.0-only-with-PDELab-exception
 #include "config.h"
 
+#include <cstdint>
+
 #include "typetreetestutility.hh"
 
 
@@ -136,6 +138,43 @@ Dune::TestSuite checkTreeContainer(const Tree& tree, const Value& value)
   return test;
 }
 
+template<class Tree, class Value>
+Dune::TestSuite checkFlatTreeContainer(const Tree& tree, const Value& value)
+{
+  Dune::TestSuite test("flat " + treeName(tree));
+
+  auto container = Dune::TypeTree::makeFlatTreeContainer<Value>(tree);
+  static_assert(std::is_same_v<decltype(container), Dune::TypeTree::FlatTreeContainer<Value,Tree>>);
+
+  test.check(reinterpret_cast<std::uintptr_t>(container.values().data()) % 64 == 0)
+    << "Values of flat tree container are not aligned";
+
+  // the values are stored in the order of the leafs
+  std::size_t k = 0;
+  Dune::TypeTree::forEachLeafNode(tree, [&] (auto&& node, auto treePath) {
+      test.check(container.index(treePath) == k and &container[treePath] == &container.values()[k])
+        << "Leaf " << k << " is not stored at position " << k << " of flat tree container";
+      container[treePath] = value;
+      ++k;
+    });
+  test.check(container.size() == k)
+    << "Flat tree container has " << container.size() << " values instead of " << k;
+
+  for (const auto& v : container.values())
+    test.check(v == value)
+      << "Value in flat tree container does not match assigned value";
+
+  // copy the container and default construct the values after resize
+  auto container2{container};
+  container2.resize(tree);
+  Dune::TypeTree::forEachLeafNode(tree, [&] (auto&& node, auto treePath) {
+      test.check(container2[treePath] == Value{} and container[treePath] == value)
+        << "Value in flat tree container does not match after copy and resize";
+    });
+
+  return test;
+}
+
 
 
 int main(int argc, char** argv)
@@ -150,16 +189,19 @@ int main(int argc, char** argv)
   SL1 sl1;
   test.subTest(checkTreeContainer(sl1, v1));
   test.subTest(checkTreeContainer(sl1, v2));
+  test.subTest(checkFlatTreeContainer(sl1, v1));
 
   using SP1 = SimplePower<SimpleLeaf,3>;
   SP1 sp1(sl1, sl1, sl1);
   test.subTest(checkTreeContainer(sp1, v1));
   test.subTest(checkTreeContainer(sp1, v2));
+  test.subTest(checkFlatTreeContainer(sp1, v1));
 
   using SDP1 = SimpleDynamicPower<SimpleLeaf>;
   SDP1 sdp1(sl1, sl1, sl1);
   test.subTest(checkTreeContainer(sdp1, v1));
   test.subTest(checkTreeContainer(sdp1, v2));
+  test.subTest(checkFlatTreeContainer(sdp1, v2));
 
   using SL2 = SimpleLeaf;
   using SP2 = SimplePower<SimpleLeaf,2>;
@@ -169,6 +211,8 @@ int main(int argc, char** argv)
   SC1 sc1_1(sl1,sp1,sp2);
   test.subTest(checkTreeContainer(sc1_1, v1));
   test.subTest(checkTreeContainer(sc1_1, v2));
+  test.subTest(checkFlatTreeContainer(sc1_1, v1));
+  test.subTest(checkFlatTreeContainer(sc1_1, v2));
 
   test.report();
 
@@ -30,7 +30,7 @@ void check(const Tree& tree)
             << "leafs: " << Info::leafCount(tree) << std::endl;
 
   if constexpr (Info::isDynamic<Tree>)
-    static_assert(Dune::Std::is_detected<Dune::TypeTree::Detail::DynamicTraversalConcept,Tree>{});
+    static_assert(Dune::TypeTree::Detail::DynamicTraversable<Tree>);
 
   TreePrinter treePrinter;
   Dune::TypeTree::applyToTree(tree,treePrinter);
@@ -63,11 +63,9 @@ struct Counter
   }
 
   int _id;
-  static int _ids;
+  inline static int _ids = 0;
 };
 
-int Counter::_ids = 0;
-
 struct SimpleLeafTag {};
 
 struct SimpleLeaf